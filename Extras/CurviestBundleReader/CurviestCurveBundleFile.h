@@ -0,0 +1,101 @@
+// Copyright 2019 Skyler Clark. All Rights Reserved.
+
+#pragma once
+
+// Maps a Curviest bundle file for tools built outside the engine, which reads files through its own platform layer.
+// Kept outside Source so engine builds never compile it or the platform headers it includes. Tools using it add
+// Source/TheCurviestCurve/Public to their include paths for CurviestCurveBundle.h.
+
+#include "CurviestCurveBundle.h"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace CurviestBundle
+{
+	/** A bundle file mapped read only, opened as a view in place */
+	class FMappedBundle
+	{
+	public:
+		FMappedBundle() = default;
+		FMappedBundle(const FMappedBundle&) = delete;
+		FMappedBundle &operator=(const FMappedBundle&) = delete;
+
+		~FMappedBundle() { Close(); }
+
+		bool Open(const char *Path)
+		{
+			Close();
+#if defined(_WIN32)
+			File = CreateFileA(Path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			LARGE_INTEGER FileSize;
+			if (File == INVALID_HANDLE_VALUE || !GetFileSizeEx(File, &FileSize) || FileSize.QuadPart == 0)
+				return Fail();
+			Mapping = CreateFileMappingA(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			Data = Mapping ? MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+			Size = (size_t)FileSize.QuadPart;
+#else
+			const int File = open(Path, O_RDONLY);
+			struct stat Stat;
+			if (File < 0 || fstat(File, &Stat) != 0 || Stat.st_size == 0)
+			{
+				if (File >= 0)
+					close(File);
+				return Fail();
+			}
+			Size = (size_t)Stat.st_size;
+			Data = mmap(nullptr, Size, PROT_READ, MAP_PRIVATE, File, 0);
+			close(File);
+			if (Data == MAP_FAILED)
+				Data = nullptr;
+#endif
+			return Data && View.Open(Data, Size) ? true : Fail();
+		}
+
+		void Close()
+		{
+#if defined(_WIN32)
+			if (Data)
+				UnmapViewOfFile(Data);
+			if (Mapping)
+				CloseHandle(Mapping);
+			if (File != INVALID_HANDLE_VALUE)
+				CloseHandle(File);
+			Mapping = nullptr;
+			File = INVALID_HANDLE_VALUE;
+#else
+			if (Data)
+				munmap(const_cast<void*>(Data), Size);
+#endif
+			Data = nullptr;
+			Size = 0;
+			View = FBundleView();
+		}
+
+		const FBundleView &GetView() const { return View; }
+
+	private:
+		bool Fail()
+		{
+			Close();
+			return false;
+		}
+
+		const void *Data = nullptr;
+		size_t Size = 0;
+		FBundleView View;
+#if defined(_WIN32)
+		HANDLE File = INVALID_HANDLE_VALUE;
+		HANDLE Mapping = nullptr;
+#endif
+	};
+}
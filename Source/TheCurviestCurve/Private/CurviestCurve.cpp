@@ -1,338 +1,1996 @@
-// Copyright 2019 Skyler Clark. All Rights Reserved.
-
-#include "CurviestCurve.h"
-
-static FName NAME_CurveDefault(TEXT("Curve_0"));
-
-float UCurveCurviestBlueprintUtils::GetValueFromCurve(UCurveBase *Curve, FName Name, float InTime)
-{
-	if (Curve)
-	{
-		TArray<FRichCurveEditInfo> EditCurves = Curve->GetCurves();
-		for (auto Elem : EditCurves)
-		{
-			if (Elem.CurveName == Name)
-				return Elem.CurveToEdit->Eval(InTime);
-		}
-	}
-	return 0.0f;
-}
-
-float UCurveCurviestBlueprintUtils::GetValueFromTaggedCurve(UCurveCurviest *Curve, FGameplayTag Tag, float InTime, bool bAllowParamLookup)
-{
-	if (Curve)
-	{
-		float Value = 0.0f;
-		Curve->GetFloatValueFromTaggedCurve(Tag, InTime, Value, bAllowParamLookup);
-		return Value;
-	}
-	return 0.0f;
-}
-
-UCurveCurviest::UCurveCurviest()
-{
-	CurveData.Add(FCurviestCurveData(NAME_CurveDefault, FLinearColor::MakeRandomColor()));
-	bLookupsNeedRebuild = true;
-}
-
-UCurveCurviest::~UCurveCurviest()
-{
-}
-
-void UCurveCurviest::RebuildLookupMaps()
-{
-	if (bLookupsNeedRebuild)
-	{
-		CurveLookupByName.Reset();
-		CurveLookupByTag.Reset();
-		for (int i = 0; i < CurveData.Num(); i++)
-		{
-			auto &Data = CurveData[i];
-			CurveLookupByName.Add(Data.Name, i);
-			CurveLookupByTag.Add(Data.IdentifierTag, i);
-		}
-
-		ParamLookupByTag.Reset();
-		for (int i = 0; i < Params.Num(); i++)
-		{
-			auto &Data = Params[i];
-			ParamLookupByTag.Add(Data.IdentifierTag, i);
-		}
-
-
-		bLookupsNeedRebuild = false;
-	}
-}
-
-
-float UCurveCurviest::GetFloatValue(FName Name, float InTime) const
-{
-	float ValueOut = 0.0f;
-	GetFloatValueFromNamedCurve(Name, InTime, ValueOut);
-	return ValueOut;
-}
-
-
-bool UCurveCurviest::GetFloatValueFromNamedCurve(FName Name, float InTime, float &ValueOut) const
-{
-	const_cast<UCurveCurviest*>(this)->RebuildLookupMaps();
-
-	const int *CurveIdx = CurveLookupByName.Find(Name);
-	if (CurveIdx)
-	{
-		ValueOut = CurveData[*CurveIdx].Curve.Eval(InTime);
-		return true;
-	}
-	return false;
-}
-
-
-bool UCurveCurviest::GetFloatValueFromTaggedCurve(FGameplayTag IdentifierTag, float InTime, float &ValueOut, bool bAllowParamLookup) const
-{
-	const_cast<UCurveCurviest*>(this)->RebuildLookupMaps();
-
-	const int *CurveIdx = CurveLookupByTag.Find(IdentifierTag);
-	if (CurveIdx)
-	{
-		ValueOut = CurveData[*CurveIdx].Curve.Eval(InTime);
-		return true;
-	}
-
-	if (bAllowParamLookup)
-	{
-		const int *ParamIdx = ParamLookupByTag.Find(IdentifierTag);
-		if (ParamIdx)
-		{
-			ValueOut = Params[*ParamIdx].Value;
-			return true;
-		}
-	}
-
-	// Check for parent data
-	if (Parent)
-		return Parent->GetFloatValueFromTaggedCurve(IdentifierTag, InTime, ValueOut, bAllowParamLookup);
-
-	return false;
-}	
-
-
-bool UCurveCurviest::GetFloatValueFromTaggedParam(FGameplayTag IdentifierTag, float &ValueOut) const
-{
-	const_cast<UCurveCurviest*>(this)->RebuildLookupMaps();
-
-	const int *ParamIdx = ParamLookupByTag.Find(IdentifierTag);
-	if (ParamIdx)
-	{
-		ValueOut = Params[*ParamIdx].Value;
-		return true;
-	}
-
-	// Check for parent data
-	if (Parent)
-		return Parent->GetFloatValueFromTaggedParam(IdentifierTag, ValueOut);
-
-	return false;
-
-}
-
-
-TArray<FGameplayTag> UCurveCurviest::GetAllCurveIdentifierTags( bool bAllowParamLookup ) const
-{
-	const_cast<UCurveCurviest*>(this)->RebuildLookupMaps();
-
-	TSet<FGameplayTag> OutTags;
-	CurveLookupByTag.GetKeys(OutTags);
-
-	if ( bAllowParamLookup )
-	{
-		TSet<FGameplayTag> OutParamTags;
-		ParamLookupByTag.GetKeys(OutParamTags);
-		OutTags = OutTags.Union(OutParamTags);
-	}
-
-	return OutTags.Array();
-}
-	
-TArray<FGameplayTag> UCurveCurviest::GetAllParamIdentifierTags() const
-{
-	const_cast<UCurveCurviest*>(this)->RebuildLookupMaps();
-
-	TSet<FGameplayTag> OutTags;
-	CurveLookupByTag.GetKeys(OutTags);
-
-	return OutTags.Array();
-}
-
-
-TArray<FRichCurveEditInfoConst> UCurveCurviest::GetCurves() const
-{
-	TArray<FRichCurveEditInfoConst> CurveEditInfos;
-	for (const auto& Data : CurveData)
-		CurveEditInfos.Add(FRichCurveEditInfoConst(&Data.Curve, Data.Name));
-	return CurveEditInfos;
-}
-
-TArray<FRichCurveEditInfo> UCurveCurviest::GetCurves()
-{
-	TArray<FRichCurveEditInfo> CurveEditInfos;
-	for (auto& Data : CurveData)
-		CurveEditInfos.Add(FRichCurveEditInfo(&Data.Curve, Data.Name));
-	return CurveEditInfos;
-}
-
-bool UCurveCurviest::IsValidCurve(FRichCurveEditInfo CurveInfo)
-{
-	for (const auto& Data : CurveData)
-		if (&Data.Curve == CurveInfo.CurveToEdit)
-			return true;
-	return false;
-}
-
-FLinearColor UCurveCurviest::GetCurveColor(FRichCurveEditInfo CurveInfo) const
-{
-	for (const auto& Data : CurveData)
-		if (CurveInfo.CurveToEdit == &Data.Curve)
-			return Data.Color;
-	return FLinearColor::White;
-}
-
-
-bool UCurveCurviest::operator==(const UCurveCurviest& Curve) const
-{
-	for (int i = 0; i < CurveData.Num(); i++)
-		if (!( CurveData[i].Curve == Curve.CurveData[i].Curve))
-			return false;
-	return true;
-}
-
-
-#if WITH_EDITOR
-
-void UCurveCurviest::MakeCurveNameUnique( int CurveIdx )
-{
-	FCurviestCurveData &Curve = CurveData[CurveIdx];
-
-	if (Curve.Name == NAME_None || Curve.Name == NAME_CurveDefault)
-	{
-		Curve.Name = NAME_CurveDefault;
-		if (Curve.IdentifierTag != FGameplayTag::EmptyTag)
-		{
-			Curve.Name = Curve.IdentifierTag.GetTagName();
-		}
-	}
-
-	// Find Name Base
-	FString BaseName = Curve.Name.ToString();
-
-	int NewNameIdx = 0;
-	FString NewName = BaseName;
-
-	int UnderscoreIdx;
-	if (BaseName.FindLastChar('_', UnderscoreIdx))
-	{
-		FString Left = BaseName.Left(UnderscoreIdx);
-		FString Right = BaseName.RightChop(UnderscoreIdx + 1);
-		if (Right.IsNumeric())
-		{
-			BaseName = Left;
-			NewNameIdx = FCString::Atoi(*Right);
-		}
-	}
-
-	// Collect Names
-	TSet<FName> NameList;
-	for (int i = 0; i < CurveData.Num(); i++)
-	{
-		if (i != CurveIdx)
-		{
-			NameList.Add(CurveData[i].Name);
-		}
-	}
-
-	// Find Unique Name
-	while (NameList.Contains(FName(*NewName)))
-	{
-		NewName = FString::Printf(TEXT("%s_%d"), *BaseName, ++NewNameIdx);
-	}
-
-	Curve.Name = FName(*NewName);
-}
-
-void UCurveCurviest::PreEditChange(class FEditPropertyChain& PropertyAboutToChange)
-{
-	Super::PreEditChange(PropertyAboutToChange);
-
-	OldCurveCount = CurveData.Num();
-}
-
-void UCurveCurviest::PostEditChangeProperty(struct FPropertyChangedEvent& e)
-{
-	const FName PropName = e.GetPropertyName();
-	if (PropName == GET_MEMBER_NAME_CHECKED(UCurveCurviest, Parent))
-	{
-		if (Parent == this)
-			Parent = nullptr;
-	}
-}
-
-void UCurveCurviest::PostEditChangeChainProperty(struct FPropertyChangedChainEvent& e)
-{
-	Super::PostEditChangeChainProperty(e);
-
-	const FName PropName = e.GetPropertyName();
-	const FName ArrayName = e.PropertyChain.GetHead()->GetValue()->GetFName();
-
-	if (ArrayName == GET_MEMBER_NAME_CHECKED(UCurveCurviest, CurveData))
-	{
-		int CurveIdx = e.GetArrayIndex(GET_MEMBER_NAME_STRING_CHECKED(UCurveCurviest, CurveData));
-		switch (e.ChangeType)
-		{
-		case EPropertyChangeType::ArrayAdd:
-			if (OldCurveCount < CurveData.Num())
-			{
-				CurveData[CurveIdx].Name = NAME_CurveDefault;
-				CurveData[CurveIdx].Color = FLinearColor::MakeRandomColor();
-				MakeCurveNameUnique(CurveIdx);
-			}
-			break;
-
-		case EPropertyChangeType::Duplicate:
-			// For whatever reason, duplicate adds the new item in the index before the selected
-			// but we want to fix up the name on the later one, not the earlier...
-			if (0 <= CurveIdx && CurveIdx + 1 < CurveData.Num())
-			{
-				MakeCurveNameUnique(CurveIdx + 1);
-			}
-			break;
-
-		case EPropertyChangeType::ValueSet:
-			if (0 <= CurveIdx)
-			{
-				if (PropName == "Name")
-				{
-					MakeCurveNameUnique(CurveIdx);
-				}
-				if (PropName == "Color")
-				{
-					CurveData[CurveIdx].Color.A = 1.0f;
-				}
-			}
-			break;
-
-		case EPropertyChangeType::ArrayClear:
-			break;
-
-		}
-
-		OnCurveMapChanged.Broadcast(this);
-
-		bLookupsNeedRebuild = true;
-
-	}
-	else if (ArrayName == GET_MEMBER_NAME_CHECKED(UCurveCurviest, Params))
-	{
-		bLookupsNeedRebuild = true;
-	}
-}
-
-#endif
\ No newline at end of file
+// Copyright 2019 Skyler Clark. All Rights Reserved.
+
+#include "CurviestCurve.h"
+#include "TheCurviestCurve.h"
+#include "Serialization/CustomVersion.h"
+#include "Curves/CurveFloat.h"
+#include "Curves/CurveVector.h"
+#include "Curves/CurveLinearColor.h"
+#include "GameplayTagsManager.h"
+#include "Misc/ScopeLock.h"
+#include "Hash/CityHash.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+static FName NAME_CurveDefault(TEXT("Curve_0"));
+
+DECLARE_CYCLE_STAT(TEXT("Build Lookups"), STAT_CurviestBuildLookups, STATGROUP_CurviestCurve);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Lookups Built On Demand"), STAT_CurviestLookupsBuiltOnDemand, STATGROUP_CurviestCurve);
+
+const FGuid FCurviestCurveCustomVersion::GUID(0x5C1A2B39, 0x8E4D4F1B, 0xA7C6D2E1, 0x3F905B74);
+static FCustomVersionRegistration GRegisterCurviestCurveCustomVersion(FCurviestCurveCustomVersion::GUID, FCurviestCurveCustomVersion::LatestVersion, TEXT("CurviestCurveVer"));
+
+// Bumped whenever any Curviest asset changes so lookup snapshots that flatten it are rebuilt
+std::atomic<uint32> UCurveCurviest::LayoutEpoch { 1 };
+
+// Index of Name among the fixed curves a built-in curve class exposes through GetCurves, read once from its CDO
+template<typename TCurveClass>
+static int FindBuiltInCurveIndex(FName Name)
+{
+	static const TArray<FName> CurveNames = []()
+	{
+		TArray<FName> Names;
+		for (const FRichCurveEditInfoConst &Info : GetDefault<TCurveClass>()->GetCurves())
+			Names.Add(Info.CurveName);
+		return Names;
+	}();
+	return CurveNames.IndexOfByKey(Name);
+}
+
+// A named curve of any non-Curviest curve asset, reading the built-in classes' curves directly
+static float EvalNamedBuiltInCurve(UCurveBase *Curve, FName Name, float InTime)
+{
+	if (UCurveFloat *FloatCurve = Cast<UCurveFloat>(Curve))
+		return FindBuiltInCurveIndex<UCurveFloat>(Name) == 0 ? FloatCurve->FloatCurve.Eval(InTime) : 0.0f;
+
+	if (UCurveVector *VectorCurve = Cast<UCurveVector>(Curve))
+	{
+		const int CurveIdx = FindBuiltInCurveIndex<UCurveVector>(Name);
+		return CurveIdx >= 0 && CurveIdx < UE_ARRAY_COUNT(VectorCurve->FloatCurves) ? VectorCurve->FloatCurves[CurveIdx].Eval(InTime) : 0.0f;
+	}
+
+	if (UCurveLinearColor *ColorCurve = Cast<UCurveLinearColor>(Curve))
+	{
+		const int CurveIdx = FindBuiltInCurveIndex<UCurveLinearColor>(Name);
+		return CurveIdx >= 0 && CurveIdx < UE_ARRAY_COUNT(ColorCurve->FloatCurves) ? ColorCurve->FloatCurves[CurveIdx].Eval(InTime) : 0.0f;
+	}
+
+	// Other classes are only read through GetCurves, which needn't be safe to call from worker threads. The library
+	// is BlueprintThreadSafe for Curviest and the classes above, so anything else gives 0 off the game thread.
+	if (!Curve || !IsInGameThread())
+		return 0.0f;
+
+	for (const FRichCurveEditInfoConst &Info : static_cast<const UCurveBase*>(Curve)->GetCurves())
+	{
+		if (Info.CurveName == Name)
+			return Info.CurveToEdit->Eval(InTime);
+	}
+	return 0.0f;
+}
+
+float UCurveCurviestBlueprintUtils::GetValueFromCurve(UCurveBase *Curve, FName Name, float InTime)
+{
+	// Cooked Curviest keys may only exist in compressed form, which the edit interface can't see
+	if (UCurveCurviest *Curviest = Cast<UCurveCurviest>(Curve))
+		return Curviest->GetFloatValue(Name, InTime);
+
+	return EvalNamedBuiltInCurve(Curve, Name, InTime);
+}
+
+float UCurveCurviestBlueprintUtils::GetValueFromTaggedCurve(UCurveCurviest *Curve, FGameplayTag Tag, float InTime, bool bAllowParamLookup)
+{
+	if (Curve)
+	{
+		float Value = 0.0f;
+		Curve->GetFloatValueFromTaggedCurve(Tag, InTime, Value, bAllowParamLookup);
+		return Value;
+	}
+	return 0.0f;
+}
+
+void UCurveCurviestBlueprintUtils::GetValuesFromCurve(UCurveBase *Curve, UCurviestCurveValueList *ValueList, float InTime, TArray<float> &Values)
+{
+	const int NumValues = ValueList ? ValueList->Num() : 0;
+	Values.SetNumUninitialized(NumValues);
+	if (NumValues == 0)
+		return;
+
+	if (UCurveCurviest *Curviest = Cast<UCurveCurviest>(Curve))
+	{
+		Curviest->GetFloatValuesFromValueList(*ValueList, InTime, Values);
+	}
+	else if (ValueList->Tags.Num() > 0)
+	{
+		for (float &Value : Values)
+			Value = 0.0f;
+	}
+	else
+	{
+		for (int i = 0; i < NumValues; i++)
+			Values[i] = EvalNamedBuiltInCurve(Curve, ValueList->Names[i], InTime);
+	}
+}
+
+float UCurveCurviestBlueprintUtils::GetValueFromValueList(UCurveBase *Curve, UCurviestCurveValueList *ValueList, int32 Index, float InTime)
+{
+	if (!ValueList || Index < 0 || Index >= ValueList->Num())
+		return 0.0f;
+
+	if (UCurveCurviest *Curviest = Cast<UCurveCurviest>(Curve))
+		return Curviest->GetFloatValueFromValueList(*ValueList, Index, InTime);
+
+	return ValueList->Tags.Num() > 0 ? 0.0f : EvalNamedBuiltInCurve(Curve, ValueList->Names[Index], InTime);
+}
+
+void UCurveCurviestBlueprintUtils::EvaluateValuesFromCurve(UCurveBase *Curve, UCurviestCurveValueList *ValueList, float InTime, TArray<float> &Values)
+{
+	GetValuesFromCurve(Curve, ValueList, InTime, Values);
+}
+
+void UCurviestCurveValueList::ResolveSlots(const UCurveCurviest *Curve)
+{
+	SlotIndices.Reset();
+	LayoutHash = 0;
+	if (!Curve)
+		return;
+
+	// The layout hash leaves out names that cooking may strip, so a name list matched against it could bind to
+	// differently named curves. Such lists stay on hashed lookups.
+	if (Tags.Num() == 0)
+	{
+		bool bHasCycle;
+		TArray<const UCurveCurviest*> Chain;
+		Curve->GetParentChain(Chain, bHasCycle);
+		for (const UCurveCurviest *Source : Chain)
+		{
+			if (Source->bStripTaggedCurveNamesOnCook)
+				return;
+		}
+	}
+
+	const FCurviestLookupPin Lookups = Curve->GetLookups();
+
+	for (int i = 0; i < Num(); i++)
+	{
+		const FCurviestEvaluationSlot *Slot = nullptr;
+		if (Tags.Num() > 0)
+		{
+			Slot = Lookups->FindTagged(Tags[i], bAllowParamLookup);
+		}
+		else if (const int *CurveIdx = Lookups->CurveLookupByName.Find(Names[i]))
+		{
+			Slot = &Lookups->EvaluationSlots[*CurveIdx];
+		}
+
+		int SlotIdx = INDEX_NONE;
+		if (Slot)
+		{
+			SlotIdx = Slot->SlotIndex;
+
+			// A curve-only lookup can find a parent curve shadowed by a param, which has no slot of its own.
+			// Leave the whole list on hashed lookups rather than mixing the two.
+			if (SlotIdx == INDEX_NONE)
+			{
+				SlotIndices.Reset();
+				return;
+			}
+		}
+		SlotIndices.Add(SlotIdx);
+	}
+
+	LayoutHash = Lookups->LayoutHash;
+}
+
+void FCurviestTagNetIndexTable::Build(const TMap<FGameplayTag, FCurviestEvaluationSlot> &Resolved, const TMap<FGameplayTag, const FCurviestEvaluationSlot*> &ParentFallbacks)
+{
+	FirstNetIndex = 0;
+	Dense.Reset();
+	Sparse.Reset();
+	Slots.Reset();
+
+	const UGameplayTagsManager &TagManager = UGameplayTagsManager::Get();
+
+	TArray<TPair<FGameplayTagNetIndex, FCurviestEvaluationSlot>> Entries;
+	Entries.Reserve(Resolved.Num() + ParentFallbacks.Num());
+	for (const TPair<FGameplayTag, FCurviestEvaluationSlot> &Pair : Resolved)
+	{
+		const FGameplayTagNetIndex NetIndex = Pair.Key.IsValid() ? TagManager.GetNetIndexFromTag(Pair.Key) : INVALID_TAGNETINDEX;
+		if (NetIndex != INVALID_TAGNETINDEX)
+			Entries.Emplace(NetIndex, Pair.Value);
+	}
+
+	// Fallbacks go in the same table, so a net index lookup never has to ask the tag manager for the tag
+	for (const TPair<FGameplayTag, const FCurviestEvaluationSlot*> &Pair : ParentFallbacks)
+	{
+		const FGameplayTagNetIndex NetIndex = TagManager.GetNetIndexFromTag(Pair.Key);
+		if (NetIndex != INVALID_TAGNETINDEX && Pair.Value)
+			Entries.Emplace(NetIndex, *Pair.Value);
+	}
+	if (Entries.Num() == 0)
+		return;
+
+	Entries.Sort([](const TPair<FGameplayTagNetIndex, FCurviestEvaluationSlot> &A, const TPair<FGameplayTagNetIndex, FCurviestEvaluationSlot> &B) { return A.Key < B.Key; });
+	for (const TPair<FGameplayTagNetIndex, FCurviestEvaluationSlot> &Entry : Entries)
+	{
+		Sparse.Add(Entry.Key);
+		Slots.Add(Entry.Value);
+	}
+
+	// A table is worth it while most of its entries are used; tags from far apart branches of the tree
+	// would leave it mostly empty, so those stay sorted and are binary searched instead
+	const int Span = (int)Sparse.Last() - (int)Sparse[0] + 1;
+	if (Span <= Sparse.Num() * 4 + 64)
+	{
+		FirstNetIndex = Sparse[0];
+		Dense.Init(INDEX_NONE, Span);
+		for (int i = 0; i < Sparse.Num(); i++)
+			Dense[Sparse[i] - FirstNetIndex] = i;
+		Sparse.Empty();
+	}
+}
+
+// Every registered descendant of a tag in Resolved that isn't in Resolved itself, mapped to its nearest ancestor that is.
+// The resolved maps already cover the parent assets, so the nearest ancestor tag wins across the whole chain.
+static void BuildParentFallbacks(const TMap<FGameplayTag, FCurviestEvaluationSlot> &Resolved, TMap<FGameplayTag, const FCurviestEvaluationSlot*> &FallbacksOut)
+{
+	const UGameplayTagsManager &TagManager = UGameplayTagsManager::Get();
+	for (const TPair<FGameplayTag, FCurviestEvaluationSlot> &Pair : Resolved)
+	{
+		if (!Pair.Key.IsValid())
+			continue;
+
+		for (const FGameplayTag &Descendant : TagManager.RequestGameplayTagChildren(Pair.Key))
+		{
+			if (Resolved.Contains(Descendant) || FallbacksOut.Contains(Descendant))
+				continue;
+
+			const FCurviestEvaluationSlot *Slot = nullptr;
+			for (FGameplayTag Ancestor = Descendant.RequestDirectParent(); Ancestor.IsValid() && !Slot; Ancestor = Ancestor.RequestDirectParent())
+				Slot = Resolved.Find(Ancestor);
+			FallbacksOut.Add(Descendant, Slot);
+		}
+	}
+}
+
+void FCurviestLookupSnapshot::AttachNetIndexTables() const
+{
+	check(IsInGameThread());
+
+	FCurviestNetIndexTables *Tables = new FCurviestNetIndexTables();
+	Tables->ValueByNetIndex.Build(ResolvedValueByTag, ParentFallbackValueByTag);
+	Tables->CurveByNetIndex.Build(ResolvedCurveByTag, ParentFallbackCurveByTag);
+	Tables->NetIndexHash = UGameplayTagsManager::Get().GetNetworkGameplayTagNodeIndexHash();
+
+	const FCurviestNetIndexTables *Expected = nullptr;
+	if (!NetIndexTables.compare_exchange_strong(Expected, Tables, std::memory_order_acq_rel, std::memory_order_acquire))
+		delete Tables;
+}
+
+SIZE_T FCurviestLookupSnapshot::GetAllocatedSize() const
+{
+	SIZE_T Bytes = sizeof(*this) + CurveLookupByName.GetAllocatedSize() + CurveLookupByTag.GetAllocatedSize() + ParamLookupByTag.GetAllocatedSize();
+	Bytes += ResolvedCurveByTag.GetAllocatedSize() + ResolvedParamByTag.GetAllocatedSize() + ResolvedValueByTag.GetAllocatedSize();
+	Bytes += EvaluationSlots.GetAllocatedSize() + CurveTags.GetAllocatedSize() + ParamTags.GetAllocatedSize() + ValueTags.GetAllocatedSize();
+	if (const FCurviestNetIndexTables *Tables = GetNetIndexTables())
+		Bytes += sizeof(*Tables) + Tables->ValueByNetIndex.GetAllocatedSize() + Tables->CurveByNetIndex.GetAllocatedSize();
+	Bytes += ParentFallbackValueByTag.GetAllocatedSize() + ParentFallbackCurveByTag.GetAllocatedSize();
+	Bytes += SlotTagContainers.GetAllocatedSize();
+	for (const FGameplayTagContainer &Container : SlotTagContainers)
+		Bytes += Container.GetGameplayTagArray().GetAllocatedSize();
+	return Bytes;
+}
+
+UCurveCurviest::UCurveCurviest()
+{
+	CurveData.Add(FCurviestCurveData(NAME_CurveDefault, FLinearColor::MakeRandomColor()));
+	RebuildSegmentCurves();
+}
+
+void UCurveCurviest::BeginDestroy()
+{
+	// Handles and snapshots of other assets may hold slots on this one, including children's through Parent
+	InvalidateLookups();
+
+	Super::BeginDestroy();
+}
+
+UCurveCurviest::~UCurveCurviest()
+{
+	// Readers may still pin the current snapshot too. Retired snapshots stay queued for them, they just no
+	// longer count towards this asset.
+	if (const FCurviestLookupSnapshot *Snapshot = LookupSnapshot.exchange(nullptr))
+		FCurviestSnapshot::Retire(Snapshot, nullptr);
+	FCurviestSnapshot::ForgetOwner(this);
+}
+
+void UCurveCurviest::PostLoad()
+{
+	Super::PostLoad();
+
+	RebuildSegmentCurves();
+	ShareIdenticalCurves();
+	RebuildSharedTimeAxes();
+	RebuildBakedCurves();
+
+	// Built from the parent's curves and params, which must have finished loading first. Not thread safe, since
+	// parent tag fallbacks ask the tag manager for tag children, so this always runs on the game thread.
+	if (Parent)
+		Parent->ConditionalPostLoad();
+
+	// Build the lookups while loading, so the first lookup doesn't hitch gameplay
+	const double StartTime = FPlatformTime::Seconds();
+	PublishLookups(LookupSnapshot.load(std::memory_order_acquire), LayoutEpoch.load(std::memory_order_acquire));
+	UE_LOG(LogCurviestCurve, Verbose, TEXT("%s: built lookups for %d curves and %d params in %.3f ms"), *GetPathName(), CurveData.Num(), Params.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+#if WITH_EDITOR
+	UpdateCompressionStats();
+#endif
+}
+
+void UCurveCurviest::Serialize(FArchive &Ar)
+{
+	Ar.UsingCustomVersion(FCurviestCurveCustomVersion::GUID);
+
+	// Packages store keys in packed blocks after the tagged properties. Transactions and other in memory
+	// archives keep them in the properties, where undo and copy paste expect them.
+	const bool bPackKeys = Ar.IsSaving() && Ar.IsPersistent() && !Ar.IsTransacting();
+
+	bool bCompressKeys = false;
+	TArray<FName> StrippedNames;
+#if WITH_EDITOR
+	bCompressKeys = Ar.IsSaving() && Ar.IsCooking() && bCompressKeysOnCook;
+
+	// Tagged curves are found by tag at runtime, so their names can stay behind
+	if (Ar.IsSaving() && Ar.IsCooking() && bStripTaggedCurveNamesOnCook)
+	{
+		StrippedNames.SetNum(CurveData.Num());
+		for (int i = 0; i < CurveData.Num(); i++)
+		{
+			if (CurveData[i].IdentifierTag.IsValid())
+				Swap(StrippedNames[i], CurveData[i].Name);
+		}
+	}
+#endif
+
+	// Swap keys out while the properties are written, then put them back
+	TArray<TArray<FRichCurveKey>> SourceKeys;
+	if (bPackKeys || bCompressKeys)
+	{
+		SourceKeys.SetNum(CurveData.Num());
+		for (int i = 0; i < CurveData.Num(); i++)
+		{
+			FCurviestCurveData &Data = CurveData[i];
+			if (bCompressKeys)
+				Data.Compressed.Build(Data.Curve);
+			if (bPackKeys || Data.Compressed.IsValid())
+				SourceKeys[i] = MoveTemp(Data.Curve.Keys);
+		}
+	}
+
+	Super::Serialize(Ar);
+
+	if (Ar.CustomVer(FCurviestCurveCustomVersion::GUID) >= FCurviestCurveCustomVersion::CompressedKeys)
+		SerializeCompressedCurves(Ar);
+
+	if (Ar.CustomVer(FCurviestCurveCustomVersion::GUID) >= FCurviestCurveCustomVersion::PackedKeys)
+		SerializePackedKeys(Ar, bPackKeys, SourceKeys);
+
+	for (int i = 0; i < SourceKeys.Num(); i++)
+	{
+		FCurviestCurveData &Data = CurveData[i];
+		if (SourceKeys[i].Num() > 0)
+			Data.Curve.Keys = MoveTemp(SourceKeys[i]);
+		if (bCompressKeys)
+			Data.Compressed.Reset();
+	}
+
+	for (int i = 0; i < StrippedNames.Num(); i++)
+	{
+		if (!StrippedNames[i].IsNone())
+			CurveData[i].Name = StrippedNames[i];
+	}
+}
+
+// One curve's keys as planar blocks, so each loads with a single memcpy and no struct padding reaches the package.
+// Tangents and weights are left out when every key has them at zero.
+static void SerializePackedKeyBlock(FArchive &Ar, TArray<FRichCurveKey> &Keys)
+{
+	enum EPackedKeyFlags : uint8
+	{
+		PKF_Tangents = 1 << 0,
+		PKF_Weights = 1 << 1,
+	};
+
+	// Every key stores at least its three mode bytes, time and value
+	constexpr int64 MinBytesPerKey = 3 + sizeof(float) * 2;
+
+	int32 NumKeys = Keys.Num();
+	Ar << NumKeys;
+	const int64 TotalSize = Ar.IsLoading() ? Ar.TotalSize() : -1;
+	if (NumKeys < 0 || (TotalSize >= 0 && NumKeys * MinBytesPerKey > TotalSize - Ar.Tell()))
+	{
+		UE_LOG(LogCurviestCurve, Error, TEXT("%s: packed key count %d doesn't fit in the rest of the archive"), *Ar.GetArchiveName(), NumKeys);
+		Ar.SetError();
+		return;
+	}
+
+	uint8 Flags = 0;
+	if (Ar.IsSaving())
+	{
+		for (const FRichCurveKey &Key : Keys)
+		{
+			if (Key.ArriveTangent != 0.0f || Key.LeaveTangent != 0.0f)
+				Flags |= PKF_Tangents;
+			if (Key.ArriveTangentWeight != 0.0f || Key.LeaveTangentWeight != 0.0f)
+				Flags |= PKF_Weights;
+		}
+	}
+	Ar << Flags;
+
+	if (Ar.IsLoading())
+		Keys.SetNum(NumKeys);
+
+	TArray<uint8> Modes;
+	if (Ar.IsSaving())
+	{
+		Modes.SetNumUninitialized(NumKeys * 3);
+		for (int i = 0; i < NumKeys; i++)
+		{
+			Modes[i * 3 + 0] = Keys[i].InterpMode;
+			Modes[i * 3 + 1] = Keys[i].TangentMode;
+			Modes[i * 3 + 2] = Keys[i].TangentWeightMode;
+		}
+	}
+	Modes.BulkSerialize(Ar);
+	if (Ar.IsLoading())
+	{
+		if (Modes.Num() != NumKeys * 3)
+		{
+			Ar.SetError();
+			return;
+		}
+		for (int i = 0; i < NumKeys; i++)
+		{
+			Keys[i].InterpMode = (ERichCurveInterpMode)Modes[i * 3 + 0];
+			Keys[i].TangentMode = (ERichCurveTangentMode)Modes[i * 3 + 1];
+			Keys[i].TangentWeightMode = (ERichCurveTangentWeightMode)Modes[i * 3 + 2];
+		}
+	}
+
+	TArray<float> Block;
+	auto SerializeBlock = [&](float FRichCurveKey::*Member)
+	{
+		if (Ar.IsSaving())
+		{
+			Block.SetNumUninitialized(NumKeys);
+			for (int i = 0; i < NumKeys; i++)
+				Block[i] = Keys[i].*Member;
+		}
+		Block.BulkSerialize(Ar);
+		if (Ar.IsLoading())
+		{
+			if (Block.Num() != NumKeys)
+			{
+				Ar.SetError();
+				return;
+			}
+			for (int i = 0; i < NumKeys; i++)
+				Keys[i].*Member = Block[i];
+		}
+	};
+
+	SerializeBlock(&FRichCurveKey::Time);
+	SerializeBlock(&FRichCurveKey::Value);
+	if (Flags & PKF_Tangents)
+	{
+		SerializeBlock(&FRichCurveKey::ArriveTangent);
+		SerializeBlock(&FRichCurveKey::LeaveTangent);
+	}
+	if (Flags & PKF_Weights)
+	{
+		SerializeBlock(&FRichCurveKey::ArriveTangentWeight);
+		SerializeBlock(&FRichCurveKey::LeaveTangentWeight);
+	}
+}
+
+void UCurveCurviest::SerializePackedKeys(FArchive &Ar, bool bPackKeys, TArray<TArray<FRichCurveKey>> &SourceKeys)
+{
+	bool bPacked = bPackKeys;
+	Ar << bPacked;
+	if (!bPacked)
+		return;
+
+	int32 NumCurves = CurveData.Num();
+	Ar << NumCurves;
+	if (NumCurves != CurveData.Num())
+	{
+		UE_LOG(LogCurviestCurve, Error, TEXT("%s: packed keys are for %d curves but %d were loaded"), *GetPathName(), NumCurves, CurveData.Num());
+		Ar.SetError();
+		return;
+	}
+
+	for (int i = 0; i < NumCurves && !Ar.IsError(); i++)
+	{
+		// Compressed curves are cooked without their source keys
+		TArray<FRichCurveKey> NoKeys;
+		if (Ar.IsSaving())
+			SerializePackedKeyBlock(Ar, CurveData[i].Compressed.IsValid() ? NoKeys : SourceKeys[i]);
+		else
+			SerializePackedKeyBlock(Ar, CurveData[i].Curve.Keys);
+	}
+}
+
+void UCurveCurviest::SerializeCompressedCurves(FArchive &Ar)
+{
+	for (FCurviestCurveData &Data : CurveData)
+	{
+		bool bCompressed = Data.Compressed.IsValid();
+		Ar << bCompressed;
+		if (bCompressed)
+			Ar << Data.Compressed;
+		else if (Ar.IsLoading())
+			Data.Compressed.Reset();
+	}
+}
+
+void UCurveCurviest::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	SIZE_T Bytes = CurveData.GetAllocatedSize() + Params.GetAllocatedSize() + SharedTimeAxes.GetAllocatedSize();
+	for (const FCurviestCurveData &Data : CurveData)
+	{
+		Bytes += Data.Curve.Keys.GetAllocatedSize() + Data.Compressed.GetAllocatedSize() + Data.Baked.GetAllocatedSize();
+		Bytes += Data.Segments.GetAllocatedSize() + Data.SearchIndex.GetAllocatedSize();
+
+		// Pooled keys are split evenly between the curves sharing them
+		if (Data.SharedCurve.IsValid())
+			Bytes += Data.SharedCurve->Keys.GetAllocatedSize() / Data.SharedCurve.GetSharedReferenceCount();
+	}
+	for (const FCurviestSharedTimeAxis &Axis : SharedTimeAxes)
+		Bytes += Axis.GetAllocatedSize();
+
+	const FCurviestLookupPin Lookups(LookupSnapshot);
+	if (Lookups.IsValid())
+		Bytes += Lookups->GetAllocatedSize();
+	Bytes += FCurviestSnapshot::GetRetiredSize(this);
+
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(Bytes);
+}
+
+void UCurveCurviest::RebuildBakedCurves()
+{
+	float MaxError = 0.0f;
+	SIZE_T MemoryBytes = 0;
+	for (FCurviestCurveData &Data : CurveData)
+	{
+		float MinTime, MaxTime;
+		if (bBakeCurves && Data.GetKeyTimeRange(MinTime, MaxTime))
+		{
+			auto Source = [&Data](float InTime) { return Data.EvalSource(InTime); };
+			MaxError = FMath::Max(MaxError, Data.Baked.Build(Source, MinTime, MaxTime, BakeSampleRate, BakeErrorTolerance, BakeMaxSamplesPerCurve));
+			MemoryBytes += Data.Baked.GetAllocatedSize();
+		}
+		else
+		{
+			Data.Baked.Reset();
+		}
+	}
+
+#if WITH_EDITORONLY_DATA
+	BakedMaxError = MaxError;
+	BakedMemoryBytes = (int)MemoryBytes;
+#endif
+	if (bBakeCurves && MaxError > BakeErrorTolerance)
+	{
+		UE_LOG(LogCurviestCurve, Warning, TEXT("%s: baked curves exceed error tolerance %f (max error %f), raise BakeMaxSamplesPerCurve"), *GetPathName(), BakeErrorTolerance, MaxError);
+	}
+}
+
+void UCurveCurviest::RebuildSegmentCurves(int CurveIdx)
+{
+	for (int i = 0; i < CurveData.Num(); i++)
+	{
+		if (CurveIdx != INDEX_NONE && i != CurveIdx)
+			continue;
+
+		// Cooked compressed curves have no source keys to build from
+		FCurviestCurveData &Data = CurveData[i];
+		const FRichCurve &Curve = Data.GetCurve();
+		Data.ContentHash = Data.Compressed.IsValid() ? FCurviestCurveEval::HashCurve(Data.Compressed) : FCurviestCurveEval::HashCurve(Curve);
+
+		if (bCacheSegmentCoefficients && !Data.Compressed.IsValid())
+			Data.Segments.Build(Curve);
+		else
+			Data.Segments.Reset();
+
+		// Picked by key count alone, small curves are faster to search in place
+		if (!Data.Compressed.IsValid() && FCurviestKeySearchIndex::ShouldBuild(Curve.Keys.Num()))
+			Data.SearchIndex.Build(Curve);
+		else
+			Data.SearchIndex.Reset();
+	}
+
+	UpdateContentHash();
+	if (CurveIdx == INDEX_NONE)
+		bContentHashMayBeStale = false;
+
+#if WITH_EDITORONLY_DATA
+	SegmentMemoryBytes = 0;
+	UncachedSegmentCurves = 0;
+	for (const FCurviestCurveData &Data : CurveData)
+	{
+		SegmentMemoryBytes += (int)(Data.Segments.GetAllocatedSize() + Data.SearchIndex.GetAllocatedSize());
+		if (bCacheSegmentCoefficients && !Data.Segments.IsValid() && Data.GetCurve().Keys.Num() >= 2)
+			UncachedSegmentCurves++;
+	}
+#endif
+}
+
+void UCurveCurviest::UpdateContentHash()
+{
+	ContentHash = CurveData.Num();
+	for (const FCurviestCurveData &Data : CurveData)
+		ContentHash = CityHash128to64(Uint128_64(ContentHash, Data.ContentHash));
+}
+
+void UCurveCurviest::ShareIdenticalCurves()
+{
+	if (!bShareIdenticalCurves || !FPlatformProperties::RequiresCookedData())
+		return;
+
+	FCurviestCurvePool &Pool = FCurviestCurvePool::Get();
+	for (FCurviestCurveData &Data : CurveData)
+	{
+		// Compressed curves have no keys left to share
+		if (Data.Compressed.IsValid() || Data.SharedCurve.IsValid() || Data.Curve.Keys.Num() == 0)
+			continue;
+
+		Data.SharedCurve = Pool.Share(MoveTemp(Data.Curve), Data.ContentHash);
+		Data.Curve.Keys.Empty();
+	}
+}
+
+void UCurveCurviest::RebuildSharedTimeAxes()
+{
+	SharedTimeAxes.Reset();
+	for (FCurviestCurveData &Data : CurveData)
+		Data.SharedTimeAxis = INDEX_NONE;
+
+	if (bShareKeyTimes && !bBakeCurves)
+	{
+		// Segment form of every curve that can have one, bucketed by a hash of its key times
+		TArray<FCurviestSegmentCurve> CurveSegments;
+		CurveSegments.SetNum(CurveData.Num());
+		TMultiMap<uint32, int> CurvesByTimeHash;
+		for (int i = 0; i < CurveData.Num(); i++)
+		{
+			const FCurviestCurveData &Data = CurveData[i];
+			if (!Data.Compressed.IsValid() && CurveSegments[i].Build(Data.GetCurve()))
+				CurvesByTimeHash.Add(FCrc::MemCrc32(CurveSegments[i].Times.GetData(), CurveSegments[i].Times.Num() * sizeof(float)), i);
+		}
+
+		TArray<int> Group;
+		TArray<FCurviestSegmentCurve> GroupSegments;
+		for (int i = 0; i < CurveData.Num(); i++)
+		{
+			if (!CurveSegments[i].IsValid() || CurveData[i].SharedTimeAxis != INDEX_NONE)
+				continue;
+
+			Group.Reset();
+			GroupSegments.Reset();
+			const uint32 TimeHash = FCrc::MemCrc32(CurveSegments[i].Times.GetData(), CurveSegments[i].Times.Num() * sizeof(float));
+			for (auto It = CurvesByTimeHash.CreateConstKeyIterator(TimeHash); It; ++It)
+			{
+				const int Other = It.Value();
+				if (CurveData[Other].SharedTimeAxis == INDEX_NONE && CurveSegments[Other].Times == CurveSegments[i].Times)
+					Group.Add(Other);
+			}
+
+			// A curve alone gains nothing from an axis
+			if (Group.Num() < 2)
+				continue;
+
+			Group.Sort();
+			for (int CurveIdx : Group)
+			{
+				CurveData[CurveIdx].SharedTimeAxis = SharedTimeAxes.Num();
+				GroupSegments.Add(MoveTemp(CurveSegments[CurveIdx]));
+			}
+			SharedTimeAxes.AddDefaulted_GetRef().Build(Group, GroupSegments);
+		}
+	}
+
+#if WITH_EDITORONLY_DATA
+	SharedTimeAxisCount = SharedTimeAxes.Num();
+	SharedTimeCurveCount = 0;
+	for (const FCurviestSharedTimeAxis &Axis : SharedTimeAxes)
+		SharedTimeCurveCount += Axis.Curves.Num();
+#endif
+}
+
+#if WITH_EDITOR
+void UCurveCurviest::UpdateCompressionStats()
+{
+	UncompressedKeyBytes = 0;
+	CompressedKeyBytes = 0;
+	CompressedMaxError = 0.0f;
+	UncompressibleCurves = 0;
+	if (!bCompressKeysOnCook)
+		return;
+
+	for (const FCurviestCurveData &Data : CurveData)
+	{
+		const int KeyBytes = (int)Data.Curve.Keys.GetAllocatedSize();
+		UncompressedKeyBytes += KeyBytes;
+
+		FCurviestCompressedCurve Compressed;
+		if (Compressed.Build(Data.Curve))
+		{
+			CompressedKeyBytes += (int)Compressed.GetAllocatedSize();
+			CompressedMaxError = FMath::Max(CompressedMaxError, Compressed.MeasureError(Data.Curve));
+		}
+		else
+		{
+			CompressedKeyBytes += KeyBytes;
+			UncompressibleCurves++;
+		}
+	}
+}
+#endif
+
+FCurviestLookupPin UCurveCurviest::GetLookups() const
+{
+	const uint32 Epoch = LayoutEpoch.load(std::memory_order_acquire);
+	FCurviestLookupPin Snapshot(LookupSnapshot);
+	if (Snapshot.IsValid() && Snapshot->Epoch == Epoch)
+	{
+		if (!bDenseTagIndex || !IsInGameThread())
+			return Snapshot;
+
+		// A current snapshot built off the game thread gets its net index tables here, and one built before tag net
+		// indices last changed is replaced. The net index hash is only asked for on the game thread, where asking
+		// can't make the tag manager rebuild its network index under another thread. Elsewhere a tag tree change
+		// reaches readers through InvalidateLookups.
+		const FCurviestNetIndexTables *Tables = Snapshot->GetNetIndexTables();
+		if (!Tables)
+		{
+			Snapshot->AttachNetIndexTables();
+			return Snapshot;
+		}
+		if (Tables->NetIndexHash == UGameplayTagsManager::Get().GetNetworkGameplayTagNodeIndexHash())
+			return Snapshot;
+	}
+
+	// Only after an edit, or for assets that were never loaded from disk
+	INC_DWORD_STAT(STAT_CurviestLookupsBuiltOnDemand);
+
+	return PublishLookups(Snapshot.Get(), Epoch);
+}
+
+FCurviestLookupPin UCurveCurviest::PublishLookups(const FCurviestLookupSnapshot *Snapshot, uint32 Epoch) const
+{
+	// Build outside any lock and publish with a single compare exchange. If another thread got there
+	// first we keep its snapshot and throw ours away, so readers never block or see a partial build.
+	FCurviestLookupSnapshot *NewSnapshot = BuildLookupSnapshot();
+	NewSnapshot->Epoch = Epoch;
+
+	// Pinned before it is published, since another thread may replace and retire it straight after
+	FCurviestLookupPin Pinned(NewSnapshot);
+
+	const FCurviestLookupSnapshot *Expected = Snapshot;
+	if (LookupSnapshot.compare_exchange_strong(Expected, NewSnapshot, std::memory_order_acq_rel, std::memory_order_acquire))
+	{
+		// Other threads may still pin it, so it lives until FCurviestSnapshot::ReclaimRetired sees it unpinned
+		if (Snapshot)
+			FCurviestSnapshot::Retire(Snapshot, this);
+		return Pinned;
+	}
+
+	Pinned = FCurviestLookupPin();
+	delete NewSnapshot;
+	return FCurviestLookupPin(LookupSnapshot);
+}
+
+void UCurveCurviest::InvalidateLookups()
+{
+	// Children cache flattened views of their parents, so any change invalidates every snapshot
+	LayoutEpoch.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void UCurveCurviest::RebuildLookupMaps()
+{
+	InvalidateLookups();
+	GetLookups();
+}
+
+void UCurveCurviest::GetParentChain(TArray<const UCurveCurviest*> &ChainOut, bool &bHasCycleOut) const
+{
+	ChainOut.Reset();
+	bHasCycleOut = false;
+	for (const UCurveCurviest *Source = this; Source; Source = Source->Parent)
+	{
+		if (ChainOut.Contains(Source))
+		{
+			bHasCycleOut = true;
+			break;
+		}
+		ChainOut.Add(Source);
+	}
+}
+
+FCurviestLookupSnapshot *UCurveCurviest::BuildLookupSnapshot() const
+{
+	SCOPE_CYCLE_COUNTER(STAT_CurviestBuildLookups);
+
+	FCurviestLookupSnapshot *Snapshot = new FCurviestLookupSnapshot();
+
+	for (int i = 0; i < CurveData.Num(); i++)
+	{
+		auto &Data = CurveData[i];
+		if (!Data.Name.IsNone())
+			Snapshot->CurveLookupByName.Add(Data.Name, i);
+		Snapshot->CurveLookupByTag.Add(Data.IdentifierTag, i);
+	}
+
+	for (int i = 0; i < Params.Num(); i++)
+	{
+		auto &Data = Params[i];
+		Snapshot->ParamLookupByTag.Add(Data.IdentifierTag, i);
+	}
+
+	TArray<const UCurveCurviest*> Chain;
+	bool bHasCycle;
+	GetParentChain(Chain, bHasCycle);
+	if (bHasCycle)
+	{
+		UE_LOG(LogCurviestCurve, Warning, TEXT("%s: Parent chain loops back on itself, ignoring parents past %s"), *GetPathName(), *Chain.Last()->GetPathName());
+	}
+
+	// Flatten the chain from the root down so nearer assets overwrite farther ones. Within an asset curves
+	// overwrite params, which gives the same answer as walking Parent one level at a time.
+	for (int ChainIdx = Chain.Num() - 1; ChainIdx >= 0; ChainIdx--)
+	{
+		const UCurveCurviest *Source = Chain[ChainIdx];
+		for (int i = 0; i < Source->Params.Num(); i++)
+		{
+			const FCurviestEvaluationSlot Slot = { Source, i, true, Source->Params[i].IdentifierTag };
+			Snapshot->ResolvedParamByTag.Add(Slot.IdentifierTag, Slot);
+			Snapshot->ResolvedValueByTag.Add(Slot.IdentifierTag, Slot);
+		}
+		for (int i = 0; i < Source->CurveData.Num(); i++)
+		{
+			const FCurviestEvaluationSlot Slot = { Source, i, false, Source->CurveData[i].IdentifierTag };
+			Snapshot->ResolvedCurveByTag.Add(Slot.IdentifierTag, Slot);
+			Snapshot->ResolvedValueByTag.Add(Slot.IdentifierTag, Slot);
+		}
+	}
+
+	// Hash names and tags by their UTF-8 text, FName indices differ between sessions and TCHAR between platforms.
+	// 64 bits since compiled lists trust a match without checking what their slots point at.
+	uint64 LayoutHash = 0;
+	auto HashString = [&LayoutHash](const FString &String)
+	{
+		FTCHARToUTF8 Utf8(*String);
+		LayoutHash = CityHash64WithSeed(Utf8.Get(), Utf8.Length(), LayoutHash);
+	};
+	auto HashValue = [&LayoutHash](int32 Value)
+	{
+		LayoutHash = CityHash64WithSeed((const char*)&Value, sizeof(Value), LayoutHash);
+	};
+	for (const UCurveCurviest *Source : Chain)
+	{
+		HashValue(Source->bStripTaggedCurveNamesOnCook);
+		HashValue(Source->CurveData.Num());
+		for (const FCurviestCurveData &Data : Source->CurveData)
+		{
+			// Left out where cooking may strip the name, so cooked and editor hashes agree
+			if (!Source->bStripTaggedCurveNamesOnCook || !Data.IdentifierTag.IsValid())
+				HashString(Data.Name.ToString());
+			HashString(Data.IdentifierTag.GetTagName().ToString());
+		}
+
+		HashValue(Source->Params.Num());
+		for (const FCurviestCurveFloatParam &Param : Source->Params)
+			HashString(Param.IdentifierTag.GetTagName().ToString());
+	}
+	HashValue(bFallBackToParentTags);
+	Snapshot->LayoutHash = LayoutHash != 0 ? LayoutHash : 1;
+
+	// Sorted once here so listing tags never allocates
+	auto GetSortedTags = [](const TMap<FGameplayTag, FCurviestEvaluationSlot> &Resolved, TArray<FGameplayTag> &TagsOut)
+	{
+		TagsOut.Reserve(Resolved.Num());
+		for (const TPair<FGameplayTag, FCurviestEvaluationSlot> &Pair : Resolved)
+		{
+			if (Pair.Key.IsValid())
+				TagsOut.Add(Pair.Key);
+		}
+		TagsOut.Sort([](const FGameplayTag &A, const FGameplayTag &B) { return A.GetTagName().LexicalLess(B.GetTagName()); });
+	};
+	GetSortedTags(Snapshot->ResolvedCurveByTag, Snapshot->CurveTags);
+	GetSortedTags(Snapshot->ResolvedParamByTag, Snapshot->ParamTags);
+	GetSortedTags(Snapshot->ResolvedValueByTag, Snapshot->ValueTags);
+
+	Snapshot->bFallBackToParentTags = bFallBackToParentTags;
+	if (bFallBackToParentTags)
+	{
+		// Built after the resolved maps are final, since the fallbacks point into them
+		BuildParentFallbacks(Snapshot->ResolvedValueByTag, Snapshot->ParentFallbackValueByTag);
+		BuildParentFallbacks(Snapshot->ResolvedCurveByTag, Snapshot->ParentFallbackCurveByTag);
+	}
+
+	TArray<FCurviestEvaluationSlot> &EvaluationSlots = Snapshot->EvaluationSlots;
+
+	// Every local curve keeps its own index so slots line up with CurveData
+	TSet<FGameplayTag> SeenTags;
+	for (int i = 0; i < CurveData.Num(); i++)
+	{
+		EvaluationSlots.Add({ this, i, false, CurveData[i].IdentifierTag });
+		SeenTags.Add(CurveData[i].IdentifierTag);
+	}
+
+	// Then everything reachable by tag that isn't shadowed, in the same order tagged lookups resolve it
+	for (const UCurveCurviest *Source : Chain)
+	{
+		if (Source != this)
+		{
+			for (int i = 0; i < Source->CurveData.Num(); i++)
+			{
+				const FGameplayTag &Tag = Source->CurveData[i].IdentifierTag;
+				if (Tag.IsValid() && !SeenTags.Contains(Tag))
+				{
+					SeenTags.Add(Tag);
+					EvaluationSlots.Add({ Source, i, false, Tag });
+				}
+			}
+		}
+
+		for (int i = 0; i < Source->Params.Num(); i++)
+		{
+			const FGameplayTag &Tag = Source->Params[i].IdentifierTag;
+			if (Tag.IsValid() && !SeenTags.Contains(Tag))
+			{
+				SeenTags.Add(Tag);
+				EvaluationSlots.Add({ Source, i, true, Tag });
+			}
+		}
+	}
+
+	// Give every resolved slot its evaluation slot index, so tagged lookups can find per slot data such as instance
+	// overrides. Local curves sharing a tag resolve to the last of them, like the resolved maps.
+	TMap<FGameplayTag, int> SlotByTag;
+	Snapshot->SlotTagContainers.Reserve(EvaluationSlots.Num());
+	for (int i = 0; i < EvaluationSlots.Num(); i++)
+	{
+		EvaluationSlots[i].SlotIndex = i;
+		if (EvaluationSlots[i].Owner == this || !SlotByTag.Contains(EvaluationSlots[i].IdentifierTag))
+			SlotByTag.Add(EvaluationSlots[i].IdentifierTag, i);
+		Snapshot->SlotTagContainers.Emplace(EvaluationSlots[i].IdentifierTag);
+	}
+	for (TMap<FGameplayTag, FCurviestEvaluationSlot> *Resolved : { &Snapshot->ResolvedCurveByTag, &Snapshot->ResolvedParamByTag, &Snapshot->ResolvedValueByTag })
+	{
+		for (TPair<FGameplayTag, FCurviestEvaluationSlot> &Pair : *Resolved)
+		{
+			// A curve or param shadowed by another with the same tag has no evaluation slot of its own
+			const int *SlotIdx = SlotByTag.Find(Pair.Key);
+			if (SlotIdx && EvaluationSlots[*SlotIdx].IsSameSource(Pair.Value))
+				Pair.Value.SlotIndex = *SlotIdx;
+		}
+	}
+
+	// Asking for a net index can make the tag manager rebuild its network index, which is only safe on the
+	// game thread. Snapshots built elsewhere get their tables from the next game thread GetLookups.
+	if (bDenseTagIndex && IsInGameThread())
+		Snapshot->AttachNetIndexTables();
+
+	return Snapshot;
+}
+
+
+int UCurveCurviest::GetNumEvaluationSlots() const
+{
+	const FCurviestLookupPin Lookups = GetLookups();
+
+	return Lookups->EvaluationSlots.Num();
+}
+
+
+TArray<FGameplayTag> UCurveCurviest::GetEvaluationSlotTags() const
+{
+	const FCurviestLookupPin Lookups = GetLookups();
+
+	TArray<FGameplayTag> OutTags;
+	OutTags.Reserve(Lookups->EvaluationSlots.Num());
+	for (const FCurviestEvaluationSlot &Slot : Lookups->EvaluationSlots)
+		OutTags.Add(Slot.IdentifierTag);
+	return OutTags;
+}
+
+
+void UCurveCurviest::EvaluateAllCurves(float InTime, TArrayView<float> ValuesOut) const
+{
+	const FCurviestLookupPin Lookups = GetLookups();
+
+	const int NumSlots = FMath::Min(ValuesOut.Num(), Lookups->EvaluationSlots.Num());
+	const FCurviestEvaluationSlot *Slots = Lookups->EvaluationSlots.GetData();
+	float *Values = ValuesOut.GetData();
+	if (SharedTimeAxes.Num() == 0 || NumSlots < Lookups->EvaluationSlots.Num())
+	{
+		for (int i = 0; i < NumSlots; i++)
+			Values[i] = Slots[i].Eval(InTime);
+		return;
+	}
+
+	// Local curves fill the first slots in CurveData order, so each axis can write its curves in place. Wide
+	// axes are evaluated a stack buffer at a time rather than into scratch space sized to the axis.
+	constexpr int ChunkSize = 64;
+	float AxisValues[ChunkSize];
+	for (const FCurviestSharedTimeAxis &Axis : SharedTimeAxes)
+	{
+		const int Segment = Axis.FindSegment(InTime);
+		if (Segment == INDEX_NONE)
+		{
+			for (int CurveIdx : Axis.Curves)
+				Values[CurveIdx] = CurveData[CurveIdx].Eval(InTime);
+			continue;
+		}
+
+		for (int First = 0; First < Axis.Curves.Num(); First += ChunkSize)
+		{
+			const int NumCurves = FMath::Min(ChunkSize, Axis.Curves.Num() - First);
+			Axis.EvalSegment(Segment, InTime, First, NumCurves, AxisValues);
+			for (int i = 0; i < NumCurves; i++)
+				Values[Axis.Curves[First + i]] = AxisValues[i];
+		}
+	}
+
+	for (int i = 0; i < NumSlots; i++)
+	{
+		if (i >= CurveData.Num() || CurveData[i].SharedTimeAxis == INDEX_NONE)
+			Values[i] = Slots[i].Eval(InTime);
+	}
+}
+
+
+FCurviestCurveHandle UCurveCurviest::ResolveTaggedHandle(FGameplayTag IdentifierTag, bool bAllowParamLookup) const
+{
+	FCurviestCurveHandle Handle;
+	Handle.IdentifierTag = IdentifierTag;
+	Handle.bAllowParamLookup = bAllowParamLookup;
+	RefreshHandle(Handle);
+	return Handle;
+}
+
+
+FCurviestCurveHandle UCurveCurviest::ResolveNamedHandle(FName Name) const
+{
+	FCurviestCurveHandle Handle;
+	Handle.Name = Name;
+	RefreshHandle(Handle);
+	return Handle;
+}
+
+
+bool UCurveCurviest::RefreshHandle(FCurviestCurveHandle &Handle) const
+{
+	if (IsHandleCurrent(Handle))
+		return Handle.IsResolved();
+
+	const FCurviestLookupPin Lookups = GetLookups();
+
+	Handle.Asset = this;
+	Handle.Generation = Lookups->Epoch;
+	Handle.Slot = FCurviestEvaluationSlot();
+
+	if (Handle.Name != NAME_None)
+	{
+		if (const int *CurveIdx = Lookups->CurveLookupByName.Find(Handle.Name))
+			Handle.Slot = { this, *CurveIdx, false, CurveData[*CurveIdx].IdentifierTag };
+	}
+	else
+	{
+		const FCurviestEvaluationSlot *Slot = Lookups->FindTagged(Handle.IdentifierTag, Handle.bAllowParamLookup);
+		if (Slot)
+			Handle.Slot = *Slot;
+	}
+
+	return Handle.IsResolved();
+}
+
+
+float UCurveCurviest::Eval(const FCurviestCurveHandle &Handle, float InTime) const
+{
+	if (IsHandleCurrent(Handle))
+		return Handle.IsResolved() ? Handle.Slot.Eval(InTime) : 0.0f;
+
+	FCurviestCurveHandle Refreshed = Handle;
+	return RefreshHandle(Refreshed) ? Refreshed.Slot.Eval(InTime) : 0.0f;
+}
+
+
+bool UCurveCurviest::EvalMany(FGameplayTag IdentifierTag, TArrayView<const float> Times, TArrayView<float> ValuesOut, bool bAllowParamLookup) const
+{
+	const FCurviestLookupPin Lookups = GetLookups();
+
+	const FCurviestEvaluationSlot *Slot = Lookups->FindTagged(IdentifierTag, bAllowParamLookup);
+	if (!Slot)
+		return false;
+
+	Slot->EvalMany(Times, ValuesOut);
+	return true;
+}
+
+
+void UCurveCurviest::EvalMany(const FCurviestCurveHandle &Handle, TArrayView<const float> Times, TArrayView<float> ValuesOut) const
+{
+	FCurviestCurveHandle Refreshed;
+	const FCurviestCurveHandle *Current = &Handle;
+	if (!IsHandleCurrent(Handle))
+	{
+		Refreshed = Handle;
+		RefreshHandle(Refreshed);
+		Current = &Refreshed;
+	}
+
+	if (Current->IsResolved())
+	{
+		Current->Slot.EvalMany(Times, ValuesOut);
+	}
+	else
+	{
+		const int NumValues = FMath::Min(Times.Num(), ValuesOut.Num());
+		for (int i = 0; i < NumValues; i++)
+			ValuesOut[i] = 0.0f;
+	}
+}
+
+
+// Indices of the slots of Lookups that Query matches, in slot order
+static void MatchQuerySlots(const FCurviestLookupSnapshot &Lookups, const FCurviestCurveQuery &Query, TArray<int> &SlotIndicesOut)
+{
+	SlotIndicesOut.Reset();
+	if (Query.Query.IsEmpty())
+		return;
+
+	for (int i = 0; i < Lookups.EvaluationSlots.Num(); i++)
+	{
+		const FCurviestEvaluationSlot &Slot = Lookups.EvaluationSlots[i];
+		if (Slot.IdentifierTag.IsValid() && (Query.bAllowParamLookup || !Slot.bIsParam) && Query.Query.Matches(Lookups.SlotTagContainers[i]))
+			SlotIndicesOut.Add(i);
+	}
+}
+
+int UCurveCurviest::CompileQuery(FCurviestCurveQuery &Query) const
+{
+	if (IsQueryCurrent(Query))
+		return Query.SlotIndices.Num();
+
+	const FCurviestLookupPin Lookups = GetLookups();
+
+	Query.Asset = this;
+	Query.Generation = Lookups->Epoch;
+	MatchQuerySlots(*Lookups, Query, Query.SlotIndices);
+
+	return Query.SlotIndices.Num();
+}
+
+
+// Call Func with each slot Query matches. A stale Query is compiled again against the same snapshot the slots are read
+// from: in place on the game thread, and into a local copy elsewhere so worker threads sharing one query never write it.
+template<typename TFunc>
+static void ForEachQuerySlot(const UCurveCurviest &Curve, FCurviestCurveQuery &Query, TFunc Func)
+{
+	const FCurviestLookupPin Lookups = Curve.GetLookups();
+
+	TArray<int> LocalSlotIndices;
+	const TArray<int> *SlotIndices = &Query.SlotIndices;
+	if (Query.Asset != &Curve || Query.Generation != Lookups->Epoch)
+	{
+		if (IsInGameThread())
+		{
+			Query.Asset = &Curve;
+			Query.Generation = Lookups->Epoch;
+			MatchQuerySlots(*Lookups, Query, Query.SlotIndices);
+		}
+		else
+		{
+			MatchQuerySlots(*Lookups, Query, LocalSlotIndices);
+			SlotIndices = &LocalSlotIndices;
+		}
+	}
+
+	const FCurviestEvaluationSlot *Slots = Lookups->EvaluationSlots.GetData();
+	for (int i = 0; i < SlotIndices->Num(); i++)
+		Func(i, Slots[(*SlotIndices)[i]]);
+}
+
+int UCurveCurviest::EvaluateQuery(FCurviestCurveQuery &Query, float InTime, TArrayView<float> ValuesOut) const
+{
+	int NumMatches = 0;
+	ForEachQuerySlot(*this, Query, [&](int MatchIdx, const FCurviestEvaluationSlot &Slot)
+	{
+		if (MatchIdx < ValuesOut.Num())
+			ValuesOut[MatchIdx] = Slot.Eval(InTime);
+		NumMatches++;
+	});
+	return NumMatches;
+}
+
+
+float UCurveCurviest::EvaluateQueryAggregate(FCurviestCurveQuery &Query, float InTime, ECurviestQueryAggregate Aggregate) const
+{
+	int NumMatches = 0;
+	float Result = Aggregate == ECurviestQueryAggregate::Product ? 1.0f : 0.0f;
+	ForEachQuerySlot(*this, Query, [&](int MatchIdx, const FCurviestEvaluationSlot &Slot)
+	{
+		const float Value = Slot.Eval(InTime);
+		switch (Aggregate)
+		{
+		case ECurviestQueryAggregate::Min:
+			Result = NumMatches == 0 ? Value : FMath::Min(Result, Value);
+			break;
+		case ECurviestQueryAggregate::Max:
+			Result = NumMatches == 0 ? Value : FMath::Max(Result, Value);
+			break;
+		case ECurviestQueryAggregate::Product:
+			Result *= Value;
+			break;
+		default:
+			Result += Value;
+			break;
+		}
+		NumMatches++;
+	});
+
+	if (Aggregate == ECurviestQueryAggregate::Average && NumMatches > 0)
+		Result /= NumMatches;
+	return Result;
+}
+
+
+void UCurveCurviest::EvaluateQueryToArray(FCurviestCurveQuery &Query, float InTime, TArray<float> &ValuesOut) const
+{
+	ValuesOut.Reset();
+	ForEachQuerySlot(*this, Query, [&](int MatchIdx, const FCurviestEvaluationSlot &Slot)
+	{
+		ValuesOut.Add(Slot.Eval(InTime));
+	});
+}
+
+
+int UCurveCurviest::CompileBlend(FCurviestCurveBlend &Blend)
+{
+	if (IsBlendCurrent(Blend))
+		return Blend.SlotTags.Num();
+
+	const int NumAssets = Blend.Assets.Num();
+	Blend.CompiledAssets.Reset(NumAssets);
+	Blend.Generation = LayoutEpoch.load(std::memory_order_acquire);
+	Blend.SlotTags.Reset();
+	Blend.SourceSlotCounts.Reset(NumAssets);
+
+	// Union of the tags in the order the assets are listed. Each asset's lookups are pinned once, so both passes
+	// read the same layout.
+	TMap<FGameplayTag, int> TagSlots;
+	TArray<FCurviestLookupPin, TInlineAllocator<8>> AssetLookups;
+	for (const UCurveCurviest *Asset : Blend.Assets)
+	{
+		Blend.CompiledAssets.Add(Asset);
+		AssetLookups.Add(Asset ? Asset->GetLookups() : FCurviestLookupPin());
+		if (!Asset)
+		{
+			Blend.SourceSlotCounts.Add(0);
+			continue;
+		}
+
+		const FCurviestLookupPin &Lookups = AssetLookups.Last();
+		Blend.SourceSlotCounts.Add(Lookups->EvaluationSlots.Num());
+		for (const FCurviestEvaluationSlot &Slot : Lookups->EvaluationSlots)
+		{
+			if (Slot.IdentifierTag.IsValid() && (Blend.bAllowParamLookup || !Slot.bIsParam) && !TagSlots.Contains(Slot.IdentifierTag))
+				TagSlots.Add(Slot.IdentifierTag, Blend.SlotTags.Add(Slot.IdentifierTag));
+		}
+	}
+
+	const int NumSlots = Blend.SlotTags.Num();
+	Blend.SourceSlots.Reset(NumAssets * NumSlots);
+	Blend.SourceMasks.Reset(NumAssets * NumSlots);
+	for (int AssetIdx = 0; AssetIdx < NumAssets; AssetIdx++)
+	{
+		const int Missing = Blend.SourceSlotCounts[AssetIdx];
+		Blend.SourceSlots.AddUninitialized(NumSlots);
+		Blend.SourceMasks.AddZeroed(NumSlots);
+		int *SourceSlots = Blend.SourceSlots.GetData() + AssetIdx * NumSlots;
+		float *SourceMasks = Blend.SourceMasks.GetData() + AssetIdx * NumSlots;
+		for (int i = 0; i < NumSlots; i++)
+			SourceSlots[i] = Missing;
+
+		if (!Blend.Assets[AssetIdx])
+			continue;
+
+		const TArray<FCurviestEvaluationSlot> &Slots = AssetLookups[AssetIdx]->EvaluationSlots;
+		for (int SlotIdx = 0; SlotIdx < Slots.Num(); SlotIdx++)
+		{
+			const FCurviestEvaluationSlot &Slot = Slots[SlotIdx];
+			const int *BlendSlot = Slot.IdentifierTag.IsValid() && (Blend.bAllowParamLookup || !Slot.bIsParam) ? TagSlots.Find(Slot.IdentifierTag) : nullptr;
+			if (BlendSlot && SourceMasks[*BlendSlot] == 0.0f)
+			{
+				SourceSlots[*BlendSlot] = SlotIdx;
+				SourceMasks[*BlendSlot] = 1.0f;
+			}
+		}
+	}
+
+	// Every slot of the largest asset plus the zero that missing tags point at
+	int MaxAssetSlots = 0;
+	for (int NumAssetSlots : Blend.SourceSlotCounts)
+		MaxAssetSlots = FMath::Max(MaxAssetSlots, NumAssetSlots);
+	Blend.WeightSum.SetNumUninitialized(NumSlots);
+	Blend.Gathered.SetNumUninitialized(NumSlots);
+	Blend.AssetValues.SetNumUninitialized(MaxAssetSlots + 1);
+
+	return NumSlots;
+}
+
+
+bool UCurveCurviest::IsBlendCurrent(const FCurviestCurveBlend &Blend)
+{
+	if (Blend.Generation != LayoutEpoch.load(std::memory_order_acquire) || Blend.CompiledAssets.Num() != Blend.Assets.Num())
+		return false;
+
+	for (int i = 0; i < Blend.Assets.Num(); i++)
+	{
+		if (Blend.CompiledAssets[i] != Blend.Assets[i])
+			return false;
+	}
+	return true;
+}
+
+
+int UCurveCurviest::EvaluateBlend(FCurviestCurveBlend &Blend, TArrayView<const float> Weights, float InTime, TArrayView<float> ValuesOut)
+{
+	CompileBlend(Blend);
+
+	const int NumSlots = Blend.SlotTags.Num();
+	const int NumValues = FMath::Min(NumSlots, ValuesOut.Num());
+
+	TArrayView<float> Sum(ValuesOut.GetData(), NumValues);
+	TArrayView<float> WeightSum(Blend.WeightSum.GetData(), NumValues);
+	for (int i = 0; i < NumValues; i++)
+	{
+		Sum[i] = 0.0f;
+		WeightSum[i] = 0.0f;
+	}
+
+	float *AssetValues = Blend.AssetValues.GetData();
+	float *Gathered = Blend.Gathered.GetData();
+	for (int AssetIdx = 0; AssetIdx < Blend.Assets.Num(); AssetIdx++)
+	{
+		const UCurveCurviest *Asset = Blend.Assets[AssetIdx];
+		const float Weight = AssetIdx < Weights.Num() ? Weights[AssetIdx] : 0.0f;
+		if (!Asset || Weight == 0.0f)
+			continue;
+
+		// Every slot of the asset plus the zero that missing tags point at
+		const int NumAssetSlots = Blend.SourceSlotCounts[AssetIdx];
+		Asset->EvaluateAllCurves(InTime, TArrayView<float>(AssetValues, NumAssetSlots));
+		AssetValues[NumAssetSlots] = 0.0f;
+
+		const int *SourceSlots = Blend.SourceSlots.GetData() + AssetIdx * NumSlots;
+		for (int i = 0; i < NumValues; i++)
+			Gathered[i] = AssetValues[SourceSlots[i]];
+
+		FCurviestCurveEval::AccumulateWeighted(Sum, WeightSum, Gathered, Blend.SourceMasks.GetData() + AssetIdx * NumSlots, Weight);
+	}
+
+	FCurviestCurveEval::NormalizeWeighted(Sum, WeightSum);
+	return NumSlots;
+}
+
+
+void UCurveCurviest::EvaluateBlendToArray(FCurviestCurveBlend &Blend, const TArray<float> &Weights, float InTime, TArray<float> &ValuesOut)
+{
+	ValuesOut.SetNumUninitialized(CompileBlend(Blend));
+	EvaluateBlend(Blend, Weights, InTime, ValuesOut);
+}
+
+
+void UCurveCurviest::Eval(TArrayView<const FCurviestCurveHandle> Handles, float InTime, TArrayView<float> ValuesOut) const
+{
+	const uint32 Epoch = LayoutEpoch.load(std::memory_order_acquire);
+	const int NumHandles = FMath::Min(Handles.Num(), ValuesOut.Num());
+	for (int i = 0; i < NumHandles; i++)
+	{
+		const FCurviestCurveHandle &Handle = Handles[i];
+		if (Handle.Asset == this && Handle.Generation == Epoch)
+			ValuesOut[i] = Handle.IsResolved() ? Handle.Slot.Eval(InTime) : 0.0f;
+		else
+			ValuesOut[i] = Eval(Handle, InTime);
+	}
+}
+
+
+float UCurveCurviest::Eval(const FCurviestCurveHandle &Handle, float InTime, FCurviestEvalCursor &Cursor) const
+{
+	if (IsHandleCurrent(Handle))
+		return Handle.IsResolved() ? Handle.Slot.Eval(InTime, Cursor) : 0.0f;
+
+	FCurviestCurveHandle Refreshed = Handle;
+	return RefreshHandle(Refreshed) ? Refreshed.Slot.Eval(InTime, Cursor) : 0.0f;
+}
+
+
+void UCurveCurviest::Eval(TArrayView<const FCurviestCurveHandle> Handles, float InTime, TArrayView<FCurviestEvalCursor> Cursors, TArrayView<float> ValuesOut) const
+{
+	const uint32 Epoch = LayoutEpoch.load(std::memory_order_acquire);
+	const int NumHandles = FMath::Min3(Handles.Num(), Cursors.Num(), ValuesOut.Num());
+	for (int i = 0; i < NumHandles; i++)
+	{
+		const FCurviestCurveHandle &Handle = Handles[i];
+		if (Handle.Asset == this && Handle.Generation == Epoch)
+			ValuesOut[i] = Handle.IsResolved() ? Handle.Slot.Eval(InTime, Cursors[i]) : 0.0f;
+		else
+			ValuesOut[i] = Eval(Handle, InTime, Cursors[i]);
+	}
+}
+
+
+float UCurveCurviest::GetFloatValueFromHandle(const FCurviestCurveHandle &Handle, float InTime) const
+{
+	return Eval(Handle, InTime);
+}
+
+
+void UCurveCurviest::EvaluateAllCurvesToArray(float InTime, TArray<float> &ValuesOut) const
+{
+	ValuesOut.SetNumUninitialized(GetNumEvaluationSlots());
+	EvaluateAllCurves(InTime, ValuesOut);
+}
+
+
+float UCurveCurviest::GetFloatValue(FName Name, float InTime) const
+{
+	float ValueOut = 0.0f;
+	GetFloatValueFromNamedCurve(Name, InTime, ValueOut);
+	return ValueOut;
+}
+
+
+bool UCurveCurviest::GetFloatValueFromNamedCurve(FName Name, float InTime, float &ValueOut) const
+{
+	const FCurviestLookupPin Lookups = GetLookups();
+
+	const int *CurveIdx = Lookups->CurveLookupByName.Find(Name);
+	if (CurveIdx)
+	{
+		ValueOut = CurveData[*CurveIdx].Eval(InTime);
+		return true;
+	}
+	return false;
+}
+
+
+bool UCurveCurviest::GetFloatValueFromNamedCurve(FName Name, float InTime, float &ValueOut, FCurviestEvalCursor &Cursor) const
+{
+	const FCurviestLookupPin Lookups = GetLookups();
+
+	const int *CurveIdx = Lookups->CurveLookupByName.Find(Name);
+	if (CurveIdx)
+	{
+		ValueOut = CurveData[*CurveIdx].Eval(InTime, Cursor);
+		return true;
+	}
+	return false;
+}
+
+
+bool UCurveCurviest::GetFloatValueFromTaggedCurve(FGameplayTag IdentifierTag, float InTime, float &ValueOut, bool bAllowParamLookup) const
+{
+	const FCurviestLookupPin Lookups = GetLookups();
+
+	// Parent data is already flattened into the resolved maps
+	const FCurviestEvaluationSlot *Slot = Lookups->FindTagged(IdentifierTag, bAllowParamLookup);
+	if (Slot)
+	{
+		ValueOut = Slot->Eval(InTime);
+		return true;
+	}
+
+	return false;
+}	
+
+
+void UCurveCurviest::GetFloatValuesFromNamedCurves(TArrayView<const FName> Names, float InTime, TArrayView<float> ValuesOut) const
+{
+	const FCurviestLookupPin Lookups = GetLookups();
+
+	const int NumValues = FMath::Min(Names.Num(), ValuesOut.Num());
+	for (int i = 0; i < NumValues; i++)
+	{
+		const int *CurveIdx = Lookups->CurveLookupByName.Find(Names[i]);
+		ValuesOut[i] = CurveIdx ? CurveData[*CurveIdx].Eval(InTime) : 0.0f;
+	}
+}
+
+
+void UCurveCurviest::GetFloatValuesFromValueList(const UCurviestCurveValueList &ValueList, float InTime, TArrayView<float> ValuesOut) const
+{
+	const FCurviestLookupPin Lookups = GetLookups();
+
+	const int NumValues = FMath::Min(ValueList.Num(), ValuesOut.Num());
+	if (ValueList.LayoutHash == Lookups->LayoutHash && ValueList.SlotIndices.Num() == ValueList.Num())
+	{
+		const int NumSlots = Lookups->EvaluationSlots.Num();
+		const FCurviestEvaluationSlot *Slots = Lookups->EvaluationSlots.GetData();
+		for (int i = 0; i < NumValues; i++)
+		{
+			// Bounds are still checked in case of a hash collision
+			const int SlotIdx = ValueList.SlotIndices[i];
+			ValuesOut[i] = SlotIdx >= 0 && SlotIdx < NumSlots ? Slots[SlotIdx].Eval(InTime) : 0.0f;
+		}
+		return;
+	}
+
+	if (ValueList.Tags.Num() > 0)
+	{
+		for (int i = 0; i < NumValues; i++)
+		{
+			const FCurviestEvaluationSlot *Slot = Lookups->FindTagged(ValueList.Tags[i], ValueList.bAllowParamLookup);
+			ValuesOut[i] = Slot ? Slot->Eval(InTime) : 0.0f;
+		}
+	}
+	else
+	{
+		for (int i = 0; i < NumValues; i++)
+		{
+			const int *CurveIdx = Lookups->CurveLookupByName.Find(ValueList.Names[i]);
+			ValuesOut[i] = CurveIdx ? CurveData[*CurveIdx].Eval(InTime) : 0.0f;
+		}
+	}
+}
+
+float UCurveCurviest::GetFloatValueFromValueList(const UCurviestCurveValueList &ValueList, int Index, float InTime) const
+{
+	if (Index < 0 || Index >= ValueList.Num())
+		return 0.0f;
+
+	const FCurviestLookupPin Lookups = GetLookups();
+
+	if (ValueList.LayoutHash == Lookups->LayoutHash && ValueList.SlotIndices.Num() == ValueList.Num())
+	{
+		const int SlotIdx = ValueList.SlotIndices[Index];
+		return SlotIdx >= 0 && SlotIdx < Lookups->EvaluationSlots.Num() ? Lookups->EvaluationSlots[SlotIdx].Eval(InTime) : 0.0f;
+	}
+
+	if (ValueList.Tags.Num() > 0)
+	{
+		const FCurviestEvaluationSlot *Slot = Lookups->FindTagged(ValueList.Tags[Index], ValueList.bAllowParamLookup);
+		return Slot ? Slot->Eval(InTime) : 0.0f;
+	}
+
+	const int *CurveIdx = Lookups->CurveLookupByName.Find(ValueList.Names[Index]);
+	return CurveIdx ? CurveData[*CurveIdx].Eval(InTime) : 0.0f;
+}
+
+void UCurveCurviest::GetFloatValuesFromTaggedCurves(const FGameplayTagContainer &Tags, float InTime, TArrayView<float> ValuesOut, bool bAllowParamLookup) const
+{
+	const FCurviestLookupPin Lookups = GetLookups();
+
+	int Idx = 0;
+	for (const FGameplayTag &Tag : Tags)
+	{
+		if (Idx >= ValuesOut.Num())
+			break;
+
+		const FCurviestEvaluationSlot *Slot = Lookups->FindTagged(Tag, bAllowParamLookup);
+		ValuesOut[Idx++] = Slot ? Slot->Eval(InTime) : 0.0f;
+	}
+}
+
+
+bool UCurveCurviest::GetFloatValueFromTagNetIndex(FGameplayTagNetIndex NetIndex, float InTime, float &ValueOut, bool bAllowParamLookup) const
+{
+	const FCurviestLookupPin Lookups = GetLookups();
+
+	// The tables include parent tag fallbacks. Without them only the game thread may go through the tag, since asking
+	// the tag manager can make it rebuild its network index.
+	const FCurviestEvaluationSlot *Slot = nullptr;
+	if (const FCurviestNetIndexTables *Tables = Lookups->GetNetIndexTables())
+		Slot = (bAllowParamLookup ? Tables->ValueByNetIndex : Tables->CurveByNetIndex).Find(NetIndex);
+	else if (IsInGameThread())
+		Slot = Lookups->FindTagged(UGameplayTagsManager::Get().GetTagFromNetIndex(NetIndex), bAllowParamLookup);
+	if (Slot)
+	{
+		ValueOut = Slot->Eval(InTime);
+		return true;
+	}
+	return false;
+}
+
+
+void UCurveCurviest::GetFloatValuesFromTagNetIndices(TArrayView<const FGameplayTagNetIndex> NetIndices, float InTime, TArrayView<float> ValuesOut, bool bAllowParamLookup) const
+{
+	const FCurviestLookupPin Lookups = GetLookups();
+
+	const int NumValues = FMath::Min(NetIndices.Num(), ValuesOut.Num());
+	const FCurviestNetIndexTables *Tables = Lookups->GetNetIndexTables();
+	if (!Tables)
+	{
+		// Same as GetFloatValueFromTagNetIndex, only the game thread may ask the tag manager
+		const bool bCanResolveTags = IsInGameThread();
+		for (int i = 0; i < NumValues; i++)
+		{
+			const FCurviestEvaluationSlot *Slot = bCanResolveTags ? Lookups->FindTagged(UGameplayTagsManager::Get().GetTagFromNetIndex(NetIndices[i]), bAllowParamLookup) : nullptr;
+			ValuesOut[i] = Slot ? Slot->Eval(InTime) : 0.0f;
+		}
+		return;
+	}
+
+	const FCurviestTagNetIndexTable &Table = bAllowParamLookup ? Tables->ValueByNetIndex : Tables->CurveByNetIndex;
+	for (int i = 0; i < NumValues; i++)
+	{
+		const FCurviestEvaluationSlot *Slot = Table.Find(NetIndices[i]);
+		ValuesOut[i] = Slot ? Slot->Eval(InTime) : 0.0f;
+	}
+}
+
+
+bool UCurveCurviest::GetFloatValueFromTaggedParam(FGameplayTag IdentifierTag, float &ValueOut) const
+{
+	const FCurviestLookupPin Lookups = GetLookups();
+
+	const FCurviestEvaluationSlot *Slot = Lookups->ResolvedParamByTag.Find(IdentifierTag);
+	if (Slot)
+	{
+		ValueOut = Slot->Owner->Params[Slot->Index].Value;
+		return true;
+	}
+
+	return false;
+
+}
+
+
+TArray<FGameplayTag> UCurveCurviest::GetAllCurveIdentifierTags( bool bAllowParamLookup ) const
+{
+	FCurviestLookupPin Lookups;
+	return TArray<FGameplayTag>(GetCurveIdentifierTagsView(Lookups, bAllowParamLookup));
+}
+	
+TArray<FGameplayTag> UCurveCurviest::GetAllParamIdentifierTags() const
+{
+	FCurviestLookupPin Lookups;
+	return TArray<FGameplayTag>(GetParamIdentifierTagsView(Lookups));
+}
+
+TArrayView<const FGameplayTag> UCurveCurviest::GetCurveIdentifierTagsView(FCurviestLookupPin &LookupsOut, bool bAllowParamLookup) const
+{
+	LookupsOut = GetLookups();
+
+	return bAllowParamLookup ? LookupsOut->ValueTags : LookupsOut->CurveTags;
+}
+
+TArrayView<const FGameplayTag> UCurveCurviest::GetParamIdentifierTagsView(FCurviestLookupPin &LookupsOut) const
+{
+	LookupsOut = GetLookups();
+
+	return LookupsOut->ParamTags;
+}
+
+
+TArray<FRichCurveEditInfoConst> UCurveCurviest::GetCurves() const
+{
+	TArray<FRichCurveEditInfoConst> CurveEditInfos;
+	for (const auto& Data : CurveData)
+		CurveEditInfos.Add(FRichCurveEditInfoConst(&Data.GetCurve(), Data.Name));
+	return CurveEditInfos;
+}
+
+TArray<FRichCurveEditInfo> UCurveCurviest::GetCurves()
+{
+	bContentHashMayBeStale = true;
+
+	TArray<FRichCurveEditInfo> CurveEditInfos;
+	for (auto& Data : CurveData)
+	{
+		// Pooled keys are shared with other assets, so edits go to a private copy
+		if (Data.SharedCurve.IsValid())
+		{
+			Data.Curve = *Data.SharedCurve;
+			Data.SharedCurve.Reset();
+		}
+		CurveEditInfos.Add(FRichCurveEditInfo(&Data.Curve, Data.Name));
+	}
+	return CurveEditInfos;
+}
+
+bool UCurveCurviest::IsValidCurve(FRichCurveEditInfo CurveInfo)
+{
+	for (const auto& Data : CurveData)
+		if (CurveInfo.CurveToEdit == &Data.Curve || CurveInfo.CurveToEdit == &Data.GetCurve())
+			return true;
+	return false;
+}
+
+FLinearColor UCurveCurviest::GetCurveColor(FRichCurveEditInfo CurveInfo) const
+{
+#if WITH_EDITORONLY_DATA
+	for (const auto& Data : CurveData)
+		if (CurveInfo.CurveToEdit == &Data.Curve || CurveInfo.CurveToEdit == &Data.GetCurve())
+			return Data.Color;
+#endif
+	return FLinearColor::White;
+}
+
+
+bool UCurveCurviest::operator==(const UCurveCurviest& Curve) const
+{
+	if (CurveData.Num() != Curve.CurveData.Num())
+		return false;
+
+	// Differing hashes only reject while both are current, since keys handed out by GetCurves() can change without
+	// a rehash. A match is always confirmed key by key.
+	if (ContentHash != Curve.ContentHash && !bContentHashMayBeStale && !Curve.bContentHashMayBeStale)
+		return false;
+
+	for (int i = 0; i < CurveData.Num(); i++)
+	{
+		const FCurviestCurveData &Data = CurveData[i];
+		const FCurviestCurveData &Other = Curve.CurveData[i];
+		if (Data.Compressed.IsValid() || Other.Compressed.IsValid())
+		{
+			if (!(Data.Compressed == Other.Compressed))
+				return false;
+		}
+		else if (&Data.GetCurve() != &Other.GetCurve() && !(Data.GetCurve() == Other.GetCurve()))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+#if WITH_EDITOR
+
+void UCurveCurviest::MakeCurveNameUnique( int CurveIdx )
+{
+	FCurviestCurveData &Curve = CurveData[CurveIdx];
+
+	if (Curve.Name == NAME_None || Curve.Name == NAME_CurveDefault)
+	{
+		Curve.Name = NAME_CurveDefault;
+		if (Curve.IdentifierTag != FGameplayTag::EmptyTag)
+		{
+			Curve.Name = Curve.IdentifierTag.GetTagName();
+		}
+	}
+
+	// Find Name Base
+	FString BaseName = Curve.Name.ToString();
+
+	int NewNameIdx = 0;
+	FString NewName = BaseName;
+
+	int UnderscoreIdx;
+	if (BaseName.FindLastChar('_', UnderscoreIdx))
+	{
+		FString Left = BaseName.Left(UnderscoreIdx);
+		FString Right = BaseName.RightChop(UnderscoreIdx + 1);
+		if (Right.IsNumeric())
+		{
+			BaseName = Left;
+			NewNameIdx = FCString::Atoi(*Right);
+		}
+	}
+
+	// Collect Names
+	TSet<FName> NameList;
+	for (int i = 0; i < CurveData.Num(); i++)
+	{
+		if (i != CurveIdx)
+		{
+			NameList.Add(CurveData[i].Name);
+		}
+	}
+
+	// Find Unique Name
+	while (NameList.Contains(FName(*NewName)))
+	{
+		NewName = FString::Printf(TEXT("%s_%d"), *BaseName, ++NewNameIdx);
+	}
+
+	Curve.Name = FName(*NewName);
+}
+
+void UCurveCurviest::PreEditChange(class FEditPropertyChain& PropertyAboutToChange)
+{
+	Super::PreEditChange(PropertyAboutToChange);
+
+	OldCurveCount = CurveData.Num();
+}
+
+void UCurveCurviest::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	InvalidateLookups();
+	RebuildSegmentCurves();
+	RebuildSharedTimeAxes();
+	RebuildBakedCurves();
+	UpdateCompressionStats();
+}
+
+void UCurveCurviest::PostEditChangeProperty(struct FPropertyChangedEvent& e)
+{
+	// Also reached from PostEditChangeChainProperty and from curve editor key edits, so derived data stays in sync.
+	// A value set inside one CurveData element only needs that curve's segments; anything else rebuilds them all.
+	int ChangedCurveIdx = INDEX_NONE;
+	if (e.ChangeType == EPropertyChangeType::ValueSet || e.ChangeType == EPropertyChangeType::Interactive)
+	{
+		ChangedCurveIdx = e.GetArrayIndex(GET_MEMBER_NAME_STRING_CHECKED(UCurveCurviest, CurveData));
+		if (!CurveData.IsValidIndex(ChangedCurveIdx))
+			ChangedCurveIdx = INDEX_NONE;
+	}
+
+	// A drag sends a change every tick, so only the dragged curve's segments keep up. Axes, baked tables and the
+	// compression stats of every curve are rebuilt once the value is set.
+	if (e.ChangeType == EPropertyChangeType::Interactive)
+	{
+		if (ChangedCurveIdx != INDEX_NONE)
+			RebuildSegmentCurves(ChangedCurveIdx);
+		return;
+	}
+
+	// Keys handed out by GetCurves() may have changed in any curve, so those edits rehash them all
+	RebuildSegmentCurves(bContentHashMayBeStale ? INDEX_NONE : ChangedCurveIdx);
+	RebuildSharedTimeAxes();
+	RebuildBakedCurves();
+	UpdateCompressionStats();
+
+	const FName PropName = e.GetPropertyName();
+	if (PropName == GET_MEMBER_NAME_CHECKED(UCurveCurviest, bDenseTagIndex) || PropName == GET_MEMBER_NAME_CHECKED(UCurveCurviest, bFallBackToParentTags)
+		|| PropName == GET_MEMBER_NAME_CHECKED(UCurveCurviest, bStripTaggedCurveNamesOnCook))
+	{
+		InvalidateLookups();
+	}
+	else if (PropName == GET_MEMBER_NAME_CHECKED(UCurveCurviest, Parent))
+	{
+		bool bHasCycle;
+		TArray<const UCurveCurviest*> Chain;
+		GetParentChain(Chain, bHasCycle);
+		if (bHasCycle)
+		{
+			UE_LOG(LogCurviestCurve, Warning, TEXT("%s: %s already inherits from this curve, clearing Parent"), *GetPathName(), *GetPathNameSafe(Parent));
+			Parent = nullptr;
+		}
+
+		InvalidateLookups();
+	}
+}
+
+void UCurveCurviest::OnCurveChanged(const TArray<FRichCurveEditInfo>& ChangedCurveEditInfos)
+{
+	Super::OnCurveChanged(ChangedCurveEditInfos);
+
+	// Keys edited through GetCurves() outside a property change, rehashed so operator== doesn't reject on a stale hash.
+	// The editor reports every curve it changed, so once they are rehashed the hashes are current again.
+	for (const FRichCurveEditInfo &Info : ChangedCurveEditInfos)
+	{
+		for (FCurviestCurveData &Data : CurveData)
+		{
+			if (Info.CurveToEdit == &Data.Curve && !Data.Compressed.IsValid())
+				Data.ContentHash = FCurviestCurveEval::HashCurve(Data.Curve);
+		}
+	}
+	UpdateContentHash();
+	bContentHashMayBeStale = false;
+}
+
+void UCurveCurviest::PostEditChangeChainProperty(struct FPropertyChangedChainEvent& e)
+{
+	Super::PostEditChangeChainProperty(e);
+
+	const FName PropName = e.GetPropertyName();
+	const FName ArrayName = e.PropertyChain.GetHead()->GetValue()->GetFName();
+
+	if (ArrayName == GET_MEMBER_NAME_CHECKED(UCurveCurviest, CurveData))
+	{
+		int CurveIdx = e.GetArrayIndex(GET_MEMBER_NAME_STRING_CHECKED(UCurveCurviest, CurveData));
+		switch (e.ChangeType)
+		{
+		case EPropertyChangeType::ArrayAdd:
+			if (OldCurveCount < CurveData.Num())
+			{
+				CurveData[CurveIdx].Name = NAME_CurveDefault;
+				CurveData[CurveIdx].Color = FLinearColor::MakeRandomColor();
+				MakeCurveNameUnique(CurveIdx);
+			}
+			break;
+
+		case EPropertyChangeType::Duplicate:
+			// For whatever reason, duplicate adds the new item in the index before the selected
+			// but we want to fix up the name on the later one, not the earlier...
+			if (0 <= CurveIdx && CurveIdx + 1 < CurveData.Num())
+			{
+				MakeCurveNameUnique(CurveIdx + 1);
+			}
+			break;
+
+		case EPropertyChangeType::ValueSet:
+			if (0 <= CurveIdx)
+			{
+				if (PropName == "Name")
+				{
+					MakeCurveNameUnique(CurveIdx);
+				}
+				if (PropName == "Color")
+				{
+					CurveData[CurveIdx].Color.A = 1.0f;
+				}
+			}
+			break;
+
+		case EPropertyChangeType::ArrayClear:
+			break;
+
+		}
+
+		OnCurveMapChanged.Broadcast(this);
+
+		InvalidateLookups();
+
+	}
+	else if (ArrayName == GET_MEMBER_NAME_CHECKED(UCurveCurviest, Params))
+	{
+		InvalidateLookups();
+	}
+}
+
+#endif
+
+#if !UE_BUILD_SHIPPING
+
+static void LogSharedCurveStats()
+{
+	int NumCurves;
+	SIZE_T PooledBytes, ReferencedBytes;
+	FCurviestCurvePool::Get().GetStats(NumCurves, PooledBytes, ReferencedBytes);
+
+	if (!FPlatformProperties::RequiresCookedData())
+	{
+		// Nothing is pooled outside cooked builds, so measure what the loaded assets would share once cooked
+		TMap<uint64, SIZE_T> UniqueBytes;
+		for (TObjectIterator<UCurveCurviest> It; It; ++It)
+		{
+			if (!It->bShareIdenticalCurves || It->HasAnyFlags(RF_ClassDefaultObject))
+				continue;
+
+			for (const FCurviestCurveData &Data : It->CurveData)
+			{
+				if (Data.Compressed.IsValid() || Data.Curve.Keys.Num() == 0)
+					continue;
+
+				const SIZE_T KeyBytes = Data.Curve.Keys.GetAllocatedSize();
+				UniqueBytes.Add(Data.ContentHash, KeyBytes);
+				ReferencedBytes += KeyBytes;
+			}
+		}
+
+		NumCurves = UniqueBytes.Num();
+		for (const TPair<uint64, SIZE_T> &Unique : UniqueBytes)
+			PooledBytes += Unique.Value;
+	}
+
+	UE_LOG(LogCurviestCurve, Display, TEXT("Shared curves%s: %d unique curves hold %llu key bytes for %llu bytes of references, saving %llu bytes"),
+		FPlatformProperties::RequiresCookedData() ? TEXT("") : TEXT(" (estimated for cooked builds)"),
+		NumCurves, (uint64)PooledBytes, (uint64)ReferencedBytes, (uint64)(ReferencedBytes - PooledBytes));
+}
+
+static FAutoConsoleCommand SharedCurveStatsCommand(
+	TEXT("Curviest.SharedCurveStats"),
+	TEXT("Log how much key memory identical curves share between Curviest assets. Outside cooked builds, estimate it from the loaded assets."),
+	FConsoleCommandDelegate::CreateStatic(&LogSharedCurveStats));
+
+#endif
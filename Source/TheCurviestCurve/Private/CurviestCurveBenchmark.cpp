@@ -0,0 +1,210 @@
+// Copyright 2019 Skyler Clark. All Rights Reserved.
+
+#include "CurviestCurveEval.h"
+#include "CurviestCurve.h"
+#include "TheCurviestCurve.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "UObject/Package.h"
+
+#if !UE_BUILD_SHIPPING
+
+// Random cubic curve with NumKeys keys over [0, NumKeys)
+static void MakeBenchmarkCurve(FRichCurve &Curve, int NumKeys, FRandomStream &Random)
+{
+	Curve.Reset();
+	for (int i = 0; i < NumKeys; i++)
+	{
+		const FKeyHandle Key = Curve.AddKey((float)i, Random.FRandRange(-1.0f, 1.0f));
+		Curve.SetKeyInterpMode(Key, RCIM_Cubic);
+	}
+	Curve.AutoSetTangents();
+}
+
+static void BenchmarkEvalMany(const TArray<FString> &Args)
+{
+	const int NumKeys = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 2) : 32;
+	const int NumTimes = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 4096;
+	const int Iterations = Args.Num() > 2 ? FMath::Max(FCString::Atoi(*Args[2]), 1) : 200;
+
+	FRandomStream Random(0x5C1A2B39);
+	FRichCurve Curve;
+	MakeBenchmarkCurve(Curve, NumKeys, Random);
+
+	// One time per agent, unsorted, with a few outside the keys to exercise extrapolation
+	TArray<float> Times;
+	Times.SetNumUninitialized(NumTimes);
+	for (float &Time : Times)
+		Time = Random.FRandRange(-0.05f * NumKeys, 1.05f * NumKeys);
+
+	TArray<float> ScalarValues;
+	TArray<float> ManyValues;
+	ScalarValues.SetNumUninitialized(NumTimes);
+	ManyValues.SetNumUninitialized(NumTimes);
+
+	const double ScalarStart = FPlatformTime::Seconds();
+	for (int Iteration = 0; Iteration < Iterations; Iteration++)
+	{
+		for (int i = 0; i < NumTimes; i++)
+			ScalarValues[i] = Curve.Eval(Times[i]);
+	}
+	const double ScalarSeconds = FPlatformTime::Seconds() - ScalarStart;
+
+	const double ManyStart = FPlatformTime::Seconds();
+	for (int Iteration = 0; Iteration < Iterations; Iteration++)
+	{
+		FCurviestCurveEval::EvalMany(Curve, Times, ManyValues);
+	}
+	const double ManySeconds = FPlatformTime::Seconds() - ManyStart;
+
+	float MaxError = 0.0f;
+	for (int i = 0; i < NumTimes; i++)
+		MaxError = FMath::Max(MaxError, FMath::Abs(ScalarValues[i] - ManyValues[i]));
+
+	const double NumEvals = (double)NumTimes * Iterations;
+	UE_LOG(LogCurviestCurve, Display, TEXT("EvalMany: %d keys, %d times x %d: FRichCurve::Eval %.2f ns/eval, EvalMany %.2f ns/eval (%.2fx), max difference %g"),
+		NumKeys, NumTimes, Iterations,
+		ScalarSeconds * 1e9 / NumEvals, ManySeconds * 1e9 / NumEvals, ManySeconds > 0.0 ? ScalarSeconds / ManySeconds : 0.0, MaxError);
+}
+
+static FAutoConsoleCommand BenchmarkEvalManyCommand(
+	TEXT("Curviest.Benchmark.EvalMany"),
+	TEXT("Compare FCurviestCurveEval::EvalMany against a scalar FRichCurve::Eval loop. Args: [NumKeys=32] [NumTimes=4096] [Iterations=200]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkEvalMany));
+
+static void BenchmarkKeySearch(const TArray<FString> &Args)
+{
+	const int NumSearches = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1 << 20;
+
+	FRandomStream Random(0x8E4D4F1B);
+	TArray<float> Queries;
+	TArray<float> PackedTimes;
+
+	for (int NumKeys = 16; NumKeys <= 1 << 18; NumKeys *= 4)
+	{
+		// Uneven key spacing like a recorded curve
+		FRichCurve Curve;
+		float Time = 0.0f;
+		for (int i = 0; i < NumKeys; i++)
+		{
+			Curve.Keys.Add(FRichCurveKey(Time, 0.0f));
+			Time += Random.FRandRange(0.01f, 0.1f);
+		}
+		const float LastTime = Curve.Keys.Last().Time;
+
+		PackedTimes.SetNumUninitialized(NumKeys);
+		for (int i = 0; i < NumKeys; i++)
+			PackedTimes[i] = Curve.Keys[i].Time;
+
+		FCurviestKeySearchIndex SearchIndex;
+		SearchIndex.Build(Curve);
+
+		Queries.SetNumUninitialized(NumSearches);
+		for (float &Query : Queries)
+			Query = Random.FRandRange(0.0f, LastTime * 0.9999f);
+
+		// Sums keep the searches from being optimized away and double as a check that they agree
+		int64 KeySum = 0;
+		const double KeyStart = FPlatformTime::Seconds();
+		for (float Query : Queries)
+			KeySum += FCurviestCurveEval::FindSegment(Curve.Keys, Query);
+		const double KeySeconds = FPlatformTime::Seconds() - KeyStart;
+
+		int64 PackedSum = 0;
+		const double PackedStart = FPlatformTime::Seconds();
+		for (float Query : Queries)
+			PackedSum += FCurviestCurveEval::FindSegment(PackedTimes.GetData(), NumKeys, Query);
+		const double PackedSeconds = FPlatformTime::Seconds() - PackedStart;
+
+		int64 IndexSum = 0;
+		const double IndexStart = FPlatformTime::Seconds();
+		for (float Query : Queries)
+			IndexSum += SearchIndex.FindSegment(Query);
+		const double IndexSeconds = FPlatformTime::Seconds() - IndexStart;
+
+		const bool bChoseIndex = FCurviestKeySearchIndex::ShouldBuild(NumKeys);
+		const bool bIndexFastest = IndexSeconds < FMath::Min(KeySeconds, PackedSeconds);
+		UE_LOG(LogCurviestCurve, Display, TEXT("KeySearch: %7d keys: keys %.2f ns, packed %.2f ns, Eytzinger %.2f ns. Runtime uses %s%s%s"),
+			NumKeys,
+			KeySeconds * 1e9 / NumSearches, PackedSeconds * 1e9 / NumSearches, IndexSeconds * 1e9 / NumSearches,
+			bChoseIndex ? TEXT("Eytzinger") : TEXT("keys"),
+			bChoseIndex != bIndexFastest ? TEXT(", which is not the fastest here") : TEXT(""),
+			KeySum != PackedSum || KeySum != IndexSum ? TEXT(". RESULTS DIFFER") : TEXT(""));
+	}
+}
+
+static FAutoConsoleCommand BenchmarkKeySearchCommand(
+	TEXT("Curviest.Benchmark.KeySearch"),
+	TEXT("Time each key search strategy over a range of key counts and show which one FCurviestKeySearchIndex::ShouldBuild picks. Args: [NumSearches=1048576]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkKeySearch));
+
+// Write Asset to memory the way a package would with bPackKeys, or with every key in the tagged properties
+static void SaveBenchmarkAsset(UCurveCurviest *Asset, bool bPackKeys, TArray<uint8> &Bytes, FCustomVersionContainer &VersionsOut)
+{
+	Bytes.Reset();
+	FMemoryWriter Writer(Bytes, bPackKeys);
+	FObjectAndNameAsStringProxyArchive Archive(Writer, false);
+	Asset->Serialize(Archive);
+	VersionsOut = Archive.GetCustomVersions();
+}
+
+static double LoadBenchmarkAsset(UCurveCurviest *Asset, const TArray<uint8> &Bytes, const FCustomVersionContainer &Versions, int Iterations)
+{
+	const double Start = FPlatformTime::Seconds();
+	for (int Iteration = 0; Iteration < Iterations; Iteration++)
+	{
+		FMemoryReader Reader(Bytes, true);
+		Reader.SetCustomVersions(Versions);
+		FObjectAndNameAsStringProxyArchive Archive(Reader, false);
+		Asset->Serialize(Archive);
+	}
+	return (FPlatformTime::Seconds() - Start) / Iterations;
+}
+
+static void BenchmarkSerialize(const TArray<FString> &Args)
+{
+	const int NumCurves = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 64;
+	const int NumKeys = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 2) : 1024;
+	const int Iterations = Args.Num() > 2 ? FMath::Max(FCString::Atoi(*Args[2]), 1) : 10;
+
+	FRandomStream Random(0x3F905B74);
+	UCurveCurviest *Source = NewObject<UCurveCurviest>(GetTransientPackage());
+	Source->CurveData.SetNum(NumCurves);
+	for (int i = 0; i < NumCurves; i++)
+	{
+		Source->CurveData[i].Name = FName(TEXT("Curve"), i + 1);
+		MakeBenchmarkCurve(Source->CurveData[i].Curve, NumKeys, Random);
+	}
+
+	UCurveCurviest *Target = NewObject<UCurveCurviest>(GetTransientPackage());
+	TArray<uint8> Bytes;
+	FCustomVersionContainer Versions;
+
+	SaveBenchmarkAsset(Source, false, Bytes, Versions);
+	const int TaggedBytes = Bytes.Num();
+	const double TaggedSeconds = LoadBenchmarkAsset(Target, Bytes, Versions, Iterations);
+
+	SaveBenchmarkAsset(Source, true, Bytes, Versions);
+	const int PackedBytes = Bytes.Num();
+	const double PackedSeconds = LoadBenchmarkAsset(Target, Bytes, Versions, Iterations);
+
+	bool bMatches = Target->CurveData.Num() == NumCurves;
+	for (int i = 0; bMatches && i < NumCurves; i++)
+		bMatches = Target->CurveData[i].Curve == Source->CurveData[i].Curve;
+
+	UE_LOG(LogCurviestCurve, Display, TEXT("Serialize: %d curves x %d keys: tagged %d bytes, %.3f ms to load; packed %d bytes, %.3f ms to load (%.2fx)%s"),
+		NumCurves, NumKeys,
+		TaggedBytes, TaggedSeconds * 1000.0, PackedBytes, PackedSeconds * 1000.0, PackedSeconds > 0.0 ? TaggedSeconds / PackedSeconds : 0.0,
+		bMatches ? TEXT("") : TEXT(". PACKED KEYS DIFFER"));
+}
+
+static FAutoConsoleCommand BenchmarkSerializeCommand(
+	TEXT("Curviest.Benchmark.Serialize"),
+	TEXT("Compare loading a synthetic asset with keys in tagged properties against packed key blocks. Args: [NumCurves=64] [KeysPerCurve=1024] [Iterations=10]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkSerialize));
+
+#endif
@@ -0,0 +1,398 @@
+// Copyright 2019 Skyler Clark. All Rights Reserved.
+
+#include "CurviestCurveBundleExport.h"
+#include "CurviestCurveBundle.h"
+#include "CurviestCurve.h"
+#include "TheCurviestCurve.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "UObject/UObjectIterator.h"
+
+static_assert(CurviestBundle::Extrap_Cycle == RCCE_Cycle && CurviestBundle::Extrap_CycleWithOffset == RCCE_CycleWithOffset && CurviestBundle::Extrap_Oscillate == RCCE_Oscillate
+	&& CurviestBundle::Extrap_Linear == RCCE_Linear && CurviestBundle::Extrap_Constant == RCCE_Constant && CurviestBundle::Extrap_None == RCCE_None, "Bundle extrapolation values must match ERichCurveExtrapolation");
+static_assert(CurviestBundle::Interp_Linear == RCIM_Linear && CurviestBundle::Interp_Constant == RCIM_Constant && CurviestBundle::Interp_Cubic == RCIM_Cubic && CurviestBundle::Interp_None == RCIM_None,
+	"Bundle interp values must match ERichCurveInterpMode");
+
+void FCurviestCurveBundleExporter::AddAsset(const UCurveCurviest *Asset)
+{
+	if (Asset)
+		Assets.AddUnique(Asset);
+}
+
+bool FCurviestCurveBundleExporter::CanExportExactly(const FCurviestCurveData &Data)
+{
+	if (Data.Compressed.IsValid())
+		return false;
+
+	const FRichCurve &Curve = Data.GetCurve();
+	const TArray<FRichCurveKey> &Keys = Curve.Keys;
+	bool bWeighted = false;
+	for (int i = 0; i + 1 < Keys.Num() && !bWeighted; i++)
+	{
+		const bool bKey1Weighted = Keys[i].TangentWeightMode == RCTWM_WeightedLeave || Keys[i].TangentWeightMode == RCTWM_WeightedBoth;
+		const bool bKey2Weighted = Keys[i + 1].TangentWeightMode == RCTWM_WeightedArrive || Keys[i + 1].TangentWeightMode == RCTWM_WeightedBoth;
+		bWeighted = Keys[i].InterpMode != RCIM_Linear && Keys[i].InterpMode != RCIM_Constant && (bKey1Weighted || bKey2Weighted);
+	}
+	if (!bWeighted)
+		return true;
+
+	// A baked table covers the whole key range, so only cycling extrapolation would map times back onto the weighted segments
+	auto Cycles = [](ERichCurveExtrapolation Extrap) { return Extrap != RCCE_Linear && Extrap != RCCE_Constant; };
+	return Data.Baked.IsValid() && !Cycles(Curve.PreInfinityExtrap) && !Cycles(Curve.PostInfinityExtrap);
+}
+
+// Appends 4 byte aligned blocks to the bundle. References into Bytes are only good until the next append.
+struct FCurviestBundleWriter
+{
+	TArray<uint8> &Bytes;
+
+	uint32 Reserve(int Size)
+	{
+		Bytes.AddZeroed(Align(Bytes.Num(), 4) - Bytes.Num());
+		const uint32 Offset = Bytes.Num();
+		Bytes.AddZeroed(Size);
+		return Offset;
+	}
+
+	uint32 Append(const void *Data, int Size)
+	{
+		const uint32 Offset = Reserve(Size);
+		if (Size > 0)
+			FMemory::Memcpy(&Bytes[Offset], Data, Size);
+		return Offset;
+	}
+
+	template<typename T>
+	uint32 AppendArray(const TArray<T> &Values)
+	{
+		return Append(Values.GetData(), Values.Num() * sizeof(T));
+	}
+
+	template<typename T>
+	T &At(uint32 Offset)
+	{
+		return *reinterpret_cast<T*>(&Bytes[Offset]);
+	}
+};
+
+static uint32 WriteBundleCurve(FCurviestBundleWriter &Writer, const FCurviestCurveData &Data)
+{
+	const FRichCurve &Curve = Data.GetCurve();
+	const TArray<FRichCurveKey> &Keys = Curve.Keys;
+	const int NumKeys = Keys.Num();
+
+	// Planar key arrays, one pass each so the reader's searches only touch times
+	TArray<float> Times, Values, ArriveTangents, LeaveTangents;
+	TArray<uint32> InterpModes;
+	Times.Reserve(NumKeys);
+	Values.Reserve(NumKeys);
+	ArriveTangents.Reserve(NumKeys);
+	LeaveTangents.Reserve(NumKeys);
+	InterpModes.Reserve(NumKeys);
+	for (const FRichCurveKey &Key : Keys)
+	{
+		Times.Add(Key.Time);
+		Values.Add(Key.Value);
+		ArriveTangents.Add(Key.ArriveTangent);
+		LeaveTangents.Add(Key.LeaveTangent);
+		InterpModes.Add(Key.InterpMode);
+	}
+
+	const uint32 CurveOffset = Writer.Reserve(sizeof(CurviestBundle::FCurve));
+	const uint32 TimesOffset = Writer.AppendArray(Times);
+	const uint32 ValuesOffset = Writer.AppendArray(Values);
+	const uint32 ArriveOffset = Writer.AppendArray(ArriveTangents);
+	const uint32 LeaveOffset = Writer.AppendArray(LeaveTangents);
+	const uint32 InterpOffset = Writer.AppendArray(InterpModes);
+	const uint32 BakedOffset = Data.Baked.IsValid() ? Writer.AppendArray(Data.Baked.Samples) : 0;
+	const uint32 SegmentsOffset = Data.Segments.IsValid() ? Writer.AppendArray(Data.Segments.Coefficients) : 0;
+
+	CurviestBundle::FCurve &Out = Writer.At<CurviestBundle::FCurve>(CurveOffset);
+	Out.DefaultValue = Curve.DefaultValue;
+	Out.PreInfinityExtrap = Curve.PreInfinityExtrap;
+	Out.PostInfinityExtrap = Curve.PostInfinityExtrap;
+	Out.NumKeys = NumKeys;
+	Out.KeyTimesOffset = TimesOffset;
+	Out.KeyValuesOffset = ValuesOffset;
+	Out.ArriveTangentsOffset = ArriveOffset;
+	Out.LeaveTangentsOffset = LeaveOffset;
+	Out.InterpModesOffset = InterpOffset;
+	if (Data.Baked.IsValid())
+	{
+		Out.BakedStartTime = Data.Baked.StartTime;
+		Out.BakedEndTime = Data.Baked.EndTime;
+		Out.BakedSamplesPerSecond = Data.Baked.SamplesPerSecond;
+		Out.NumBakedSamples = Data.Baked.Samples.Num();
+		Out.BakedSamplesOffset = BakedOffset;
+	}
+	Out.SegmentCoefficientsOffset = SegmentsOffset;
+	return CurveOffset;
+}
+
+int FCurviestCurveBundleExporter::Write(TArray<uint8> &BytesOut) const
+{
+	BytesOut.Reset();
+	FCurviestBundleWriter Writer{ BytesOut };
+
+	const uint32 HeaderOffset = Writer.Reserve(sizeof(CurviestBundle::FHeader));
+	const uint32 AssetsOffset = Writer.Reserve(Assets.Num() * sizeof(CurviestBundle::FAsset));
+
+	// Curves shared through parent chains and strings shared between assets are written once
+	TMap<TPair<const UCurveCurviest*, int>, uint32> CurveOffsets;
+	TMap<FString, uint32> StringOffsets;
+	int UnsupportedCurves = 0;
+
+	auto WriteString = [&](const FString &String, uint32 &LengthOut)
+	{
+		const FTCHARToUTF8 Utf8(*String);
+		LengthOut = Utf8.Length();
+		if (const uint32 *Existing = StringOffsets.Find(String))
+			return *Existing;
+		return StringOffsets.Add(String, Writer.Append(Utf8.Get(), Utf8.Length()));
+	};
+
+	auto WriteEntries = [&](const TMap<FGameplayTag, FCurviestEvaluationSlot> &Resolved, uint32 &NumEntriesOut)
+	{
+		struct FSortedEntry
+		{
+			FString Tag;
+			FTCHARToUTF8 Utf8;
+			const FCurviestEvaluationSlot *Slot;
+
+			FSortedEntry(const FGameplayTag &InTag, const FCurviestEvaluationSlot *InSlot) : Tag(InTag.ToString()), Utf8(*Tag), Slot(InSlot) {}
+		};
+
+		// Untagged curves can't be looked up by tag and are left out
+		TArray<TUniquePtr<FSortedEntry>> Sorted;
+		for (const TPair<FGameplayTag, FCurviestEvaluationSlot> &Pair : Resolved)
+		{
+			if (Pair.Key.IsValid())
+				Sorted.Add(MakeUnique<FSortedEntry>(Pair.Key, &Pair.Value));
+		}
+		Sorted.Sort([](const TUniquePtr<FSortedEntry> &A, const TUniquePtr<FSortedEntry> &B)
+		{
+			return CurviestBundle::CompareTags(A->Utf8.Get(), A->Utf8.Length(), B->Utf8.Get(), B->Utf8.Length()) < 0;
+		});
+
+		NumEntriesOut = Sorted.Num();
+		const uint32 EntriesOffset = Writer.Reserve(Sorted.Num() * sizeof(CurviestBundle::FEntry));
+		for (int i = 0; i < Sorted.Num(); i++)
+		{
+			const FCurviestEvaluationSlot &Slot = *Sorted[i]->Slot;
+			uint32 TagLength = 0;
+			const uint32 TagOffset = WriteString(Sorted[i]->Tag, TagLength);
+
+			uint32 CurveOffset = 0;
+			float ParamValue = 0.0f;
+			if (Slot.bIsParam)
+			{
+				ParamValue = Slot.Owner->Params[Slot.Index].Value;
+			}
+			else if (const uint32 *Existing = CurveOffsets.Find(TPair<const UCurveCurviest*, int>(Slot.Owner, Slot.Index)))
+			{
+				CurveOffset = *Existing;
+			}
+			else
+			{
+				const FCurviestCurveData &Data = Slot.Owner->CurveData[Slot.Index];
+				if (CanExportExactly(Data))
+				{
+					CurveOffset = WriteBundleCurve(Writer, Data);
+				}
+				else
+				{
+					UE_LOG(LogCurviestCurve, Warning, TEXT("%s: curve %s has compressed keys or weighted tangents and is written as unsupported"), *Slot.Owner->GetPathName(), *Sorted[i]->Tag);
+					CurveOffset = CurviestBundle::UnsupportedCurve;
+					UnsupportedCurves++;
+				}
+				CurveOffsets.Add(TPair<const UCurveCurviest*, int>(Slot.Owner, Slot.Index), CurveOffset);
+			}
+
+			CurviestBundle::FEntry &Entry = Writer.At<CurviestBundle::FEntry>(EntriesOffset + i * sizeof(CurviestBundle::FEntry));
+			Entry.TagOffset = TagOffset;
+			Entry.TagLength = TagLength;
+			Entry.CurveOffset = CurveOffset;
+			Entry.ParamValue = ParamValue;
+		}
+		return EntriesOffset;
+	};
+
+	for (int AssetIdx = 0; AssetIdx < Assets.Num(); AssetIdx++)
+	{
+		const UCurveCurviest *Asset = Assets[AssetIdx];
+		const FCurviestLookupPin Lookups = Asset->GetLookups();
+
+		CurviestBundle::FAsset Out = {};
+		Out.Flags = Lookups->bFallBackToParentTags ? CurviestBundle::AF_FallBackToParentTags : 0;
+		Out.NameOffset = WriteString(Asset->GetPathName(), Out.NameLength);
+		Out.CurveEntriesOffset = WriteEntries(Lookups->ResolvedCurveByTag, Out.NumCurveEntries);
+		Out.ValueEntriesOffset = WriteEntries(Lookups->ResolvedValueByTag, Out.NumValueEntries);
+		Writer.At<CurviestBundle::FAsset>(AssetsOffset + AssetIdx * sizeof(CurviestBundle::FAsset)) = Out;
+	}
+
+	Writer.Reserve(0);
+	CurviestBundle::FHeader &Header = Writer.At<CurviestBundle::FHeader>(HeaderOffset);
+	Header.Magic = CurviestBundle::Magic;
+	Header.Version = CurviestBundle::Version;
+	Header.TotalSize = BytesOut.Num();
+	Header.NumAssets = Assets.Num();
+	Header.AssetsOffset = AssetsOffset;
+	return UnsupportedCurves;
+}
+
+#if !UE_BUILD_SHIPPING
+
+// Assets named by object path in Args, or every loaded Curviest asset when there are none
+static TArray<const UCurveCurviest*> FindBundleAssets(TArrayView<const FString> Args)
+{
+	TArray<const UCurveCurviest*> Assets;
+	for (const FString &Path : Args)
+	{
+		if (const UCurveCurviest *Asset = LoadObject<UCurveCurviest>(nullptr, *Path))
+			Assets.Add(Asset);
+		else
+			UE_LOG(LogCurviestCurve, Warning, TEXT("Bundle: no Curviest asset at %s"), *Path);
+	}
+
+	if (Args.Num() == 0)
+	{
+		for (TObjectIterator<UCurveCurviest> It; It; ++It)
+		{
+			if (!It->HasAnyFlags(RF_ClassDefaultObject))
+				Assets.Add(*It);
+		}
+	}
+	return Assets;
+}
+
+static void ExportBundle(const TArray<FString> &Args)
+{
+	if (Args.Num() == 0)
+	{
+		UE_LOG(LogCurviestCurve, Warning, TEXT("Bundle: expected an output file"));
+		return;
+	}
+
+	FCurviestCurveBundleExporter Exporter;
+	const TArray<const UCurveCurviest*> Assets = FindBundleAssets(TArrayView<const FString>(Args.GetData() + 1, Args.Num() - 1));
+	for (const UCurveCurviest *Asset : Assets)
+		Exporter.AddAsset(Asset);
+
+	TArray<uint8> Bytes;
+	const int UnsupportedCurves = Exporter.Write(Bytes);
+	if (!FFileHelper::SaveArrayToFile(Bytes, *Args[0]))
+	{
+		UE_LOG(LogCurviestCurve, Warning, TEXT("Bundle: couldn't write %s"), *Args[0]);
+		return;
+	}
+
+	UE_LOG(LogCurviestCurve, Display, TEXT("Bundle: wrote %d assets to %s, %d bytes, %d unsupported curves"), Assets.Num(), *Args[0], Bytes.Num(), UnsupportedCurves);
+}
+
+static FAutoConsoleCommand ExportBundleCommand(
+	TEXT("Curviest.Bundle.Export"),
+	TEXT("Write Curviest assets to a standalone bundle for CurviestCurveBundle.h. Args: OutFile [AssetPath...], all loaded assets if no paths are given"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&ExportBundle));
+
+// Times around a curve's keys: each key, each midpoint, and random times out to two durations either side for extrapolation
+static void GetCrossCheckTimes(const FCurviestCurveData &Data, FRandomStream &Random, TArray<float> &TimesOut)
+{
+	TimesOut.Reset();
+	const TArray<FRichCurveKey> &Keys = Data.GetCurve().Keys;
+	for (int i = 0; i < Keys.Num(); i++)
+	{
+		TimesOut.Add(Keys[i].Time);
+		if (i + 1 < Keys.Num())
+			TimesOut.Add((Keys[i].Time + Keys[i + 1].Time) * 0.5f);
+	}
+
+	float MinTime = 0.0f, MaxTime = 0.0f;
+	Data.GetKeyTimeRange(MinTime, MaxTime);
+	const float Margin = (MaxTime - MinTime) * 2.0f + 1.0f;
+	for (int i = 0; i < 64; i++)
+		TimesOut.Add(Random.FRandRange(MinTime - Margin, MaxTime + Margin));
+}
+
+static void CrossCheckBundle(const TArray<FString> &Args)
+{
+	FCurviestCurveBundleExporter Exporter;
+	const TArray<const UCurveCurviest*> Assets = FindBundleAssets(Args);
+	if (Assets.Num() == 0)
+	{
+		UE_LOG(LogCurviestCurve, Warning, TEXT("Bundle: no Curviest assets to check. Plugins.TheCurviestCurve.Bundle.CrossCheck runs without any."));
+		return;
+	}
+	for (const UCurveCurviest *Asset : Assets)
+		Exporter.AddAsset(Asset);
+
+	TArray<uint8> Bytes;
+	const int UnsupportedCurves = Exporter.Write(Bytes);
+
+	CurviestBundle::FBundleView View;
+	if (!View.Open(Bytes.GetData(), Bytes.Num()))
+	{
+		UE_LOG(LogCurviestCurve, Warning, TEXT("Bundle: reader rejected the exported bundle"));
+		return;
+	}
+
+	// Every tagged value through both lookups, compared bit for bit against the asset
+	FRandomStream Random(0x2F6B91C7);
+	TArray<float> Times;
+	int NumSamples = 0;
+	int NumMismatches = 0;
+	for (const UCurveCurviest *Asset : Assets)
+	{
+		const CurviestBundle::FAsset *BundleAsset = View.FindAsset(TCHAR_TO_UTF8(*Asset->GetPathName()));
+		const FCurviestLookupPin Lookups = Asset->GetLookups();
+		for (const bool bAllowParamLookup : { false, true })
+		{
+			for (const FGameplayTag &Tag : bAllowParamLookup ? Lookups->ValueTags : Lookups->CurveTags)
+			{
+				const FCurviestEvaluationSlot *Slot = Lookups->FindTagged(Tag, bAllowParamLookup);
+				if (!Slot || !Tag.IsValid())
+					continue;
+
+				if (Slot->bIsParam)
+				{
+					Times.Reset();
+					Times.Add(0.0f);
+				}
+				else if (!FCurviestCurveBundleExporter::CanExportExactly(Slot->Owner->CurveData[Slot->Index]))
+				{
+					continue;
+				}
+				else
+				{
+					GetCrossCheckTimes(Slot->Owner->CurveData[Slot->Index], Random, Times);
+				}
+
+				const FTCHARToUTF8 TagName(*Tag.ToString());
+				for (const float Time : Times)
+				{
+					float Expected = 0.0f;
+					float Actual = 0.0f;
+					Asset->GetFloatValueFromTaggedCurve(Tag, Time, Expected, bAllowParamLookup);
+					const bool bFound = BundleAsset && View.Eval(*BundleAsset, TagName.Get(), Time, Actual, bAllowParamLookup);
+					NumSamples++;
+
+					if (!bFound || FMemory::Memcmp(&Expected, &Actual, sizeof(float)) != 0)
+					{
+						if (NumMismatches++ < 16)
+							UE_LOG(LogCurviestCurve, Warning, TEXT("Bundle: %s %s at %g is %g, bundle gives %s"), *Asset->GetPathName(), *Tag.ToString(), Time, Expected, bFound ? *FString::SanitizeFloat(Actual) : TEXT("nothing"));
+					}
+				}
+			}
+		}
+	}
+
+	UE_LOG(LogCurviestCurve, Display, TEXT("Bundle: %d assets, %d bytes, %d samples, %d mismatches, %d unsupported curves skipped"),
+		Assets.Num(), Bytes.Num(), NumSamples, NumMismatches, UnsupportedCurves);
+}
+
+static FAutoConsoleCommand CrossCheckBundleCommand(
+	TEXT("Curviest.Bundle.CrossCheck"),
+	TEXT("Export Curviest assets to a bundle in memory and check CurviestCurveBundle.h evaluates every tag bit for bit the same. Args: [AssetPath...], all loaded assets if none are given"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&CrossCheckBundle));
+
+#endif
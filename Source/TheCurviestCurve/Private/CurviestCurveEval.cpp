@@ -0,0 +1,985 @@
+// Copyright 2019 Skyler Clark. All Rights Reserved.
+
+#include "CurviestCurveEval.h"
+#include "Math/VectorRegister.h"
+#include "Hash/CityHash.h"
+#include "Misc/ScopeLock.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+#if ENGINE_MAJOR_VERSION >= 5
+typedef VectorRegister4Float FCurviestVector;
+#else
+typedef VectorRegister FCurviestVector;
+#endif
+
+float FCurviestBakedCurve::Build(TFunctionRef<float(float)> Source, float Start, float End, float InSamplesPerSecond, float Tolerance, int MaxSamples)
+{
+	Reset();
+
+	const float Duration = End - Start;
+	if (Duration <= 0.0f)
+		return 0.0f;
+
+	MaxSamples = FMath::Max(MaxSamples, 2);
+	int NumIntervals = FMath::Clamp(FMath::CeilToInt(Duration * FMath::Max(InSamplesPerSecond, KINDA_SMALL_NUMBER)), 1, MaxSamples - 1);
+
+	float MaxError = 0.0f;
+	for (;;)
+	{
+		StartTime = Start;
+		EndTime = End;
+		SamplesPerSecond = NumIntervals / Duration;
+
+		Samples.SetNumUninitialized(NumIntervals + 1);
+		for (int i = 0; i <= NumIntervals; i++)
+			Samples[i] = Source(Start + i / SamplesPerSecond);
+
+		// Measure between samples, where the lerp is furthest from the source
+		MaxError = 0.0f;
+		for (int i = 0; i < NumIntervals; i++)
+		{
+			for (float Fraction : { 0.25f, 0.5f, 0.75f })
+			{
+				const float Time = Start + (i + Fraction) / SamplesPerSecond;
+				MaxError = FMath::Max(MaxError, FMath::Abs(EvalInRange(Time) - Source(Time)));
+			}
+		}
+
+		if (MaxError <= Tolerance || NumIntervals + 1 >= MaxSamples)
+			break;
+
+		NumIntervals = FMath::Min(NumIntervals * 2, MaxSamples - 1);
+	}
+
+	Samples.Shrink();
+	return MaxError;
+}
+
+static uint16 QuantizeToStep(float Value, float Min, float Step)
+{
+	return Step > 0.0f ? (uint16)FMath::Clamp(FMath::RoundToInt((Value - Min) / Step), 0, (int)MAX_uint16) : 0;
+}
+
+bool FCurviestCompressedCurve::Build(const FRichCurve &Curve)
+{
+	Reset();
+
+	const TArray<FRichCurveKey> &Keys = Curve.Keys;
+	const int NumKeys = Keys.Num();
+
+	float MinValue = MAX_flt;
+	float MaxValue = -MAX_flt;
+	int NumCubic = 0;
+	for (int i = 0; i < NumKeys; i++)
+	{
+		const FRichCurveKey &Key = Keys[i];
+		MinValue = FMath::Min(MinValue, Key.Value);
+		MaxValue = FMath::Max(MaxValue, Key.Value);
+
+		if (i + 1 < NumKeys && Key.InterpMode != RCIM_Constant && Key.InterpMode != RCIM_Linear)
+		{
+			float Unused;
+			if (!FCurviestCurveEval::EvalSegment(Key, Keys[i + 1], Key.Time, Unused))
+				return false;
+			NumCubic++;
+		}
+	}
+
+	// TangentIndex holds two tangents per cubic segment, and MAX_uint16 is the sentinel for keys without any
+	if (NumCubic * 2 >= MAX_uint16)
+		return false;
+
+	DefaultValue = Curve.DefaultValue;
+	PreInfinityExtrap = (uint8)Curve.PreInfinityExtrap.GetValue();
+	PostInfinityExtrap = (uint8)Curve.PostInfinityExtrap.GetValue();
+
+	if (NumKeys > 0)
+	{
+		TimeMin = Keys[0].Time;
+		TimeStep = (Keys[NumKeys - 1].Time - TimeMin) / MAX_uint16;
+		ValueMin = MinValue;
+		ValueStep = (MaxValue - MinValue) / MAX_uint16;
+	}
+
+	Times.SetNumUninitialized(NumKeys);
+	Values.SetNumUninitialized(NumKeys);
+	InterpModes.SetNumUninitialized(NumKeys);
+	TangentIndex.SetNumUninitialized(NumKeys);
+	Tangents.Reserve(NumCubic * 2);
+	for (int i = 0; i < NumKeys; i++)
+	{
+		const FRichCurveKey &Key = Keys[i];
+		Times[i] = QuantizeToStep(Key.Time, TimeMin, TimeStep);
+		Values[i] = QuantizeToStep(Key.Value, ValueMin, ValueStep);
+		InterpModes[i] = (uint8)Key.InterpMode.GetValue();
+		TangentIndex[i] = MAX_uint16;
+
+		if (i + 1 < NumKeys && Key.InterpMode != RCIM_Constant && Key.InterpMode != RCIM_Linear)
+		{
+			TangentIndex[i] = (uint16)Tangents.Num();
+			Tangents.Add(Key.LeaveTangent);
+			Tangents.Add(Keys[i + 1].ArriveTangent);
+		}
+	}
+
+	bIsCompressed = true;
+	return true;
+}
+
+float FCurviestCompressedCurve::MeasureError(const FRichCurve &Curve) const
+{
+	float MaxError = 0.0f;
+	const TArray<FRichCurveKey> &Keys = Curve.Keys;
+	for (int i = 0; i < Keys.Num(); i++)
+	{
+		MaxError = FMath::Max(MaxError, FMath::Abs(Eval(Keys[i].Time) - Curve.Eval(Keys[i].Time)));
+		if (i + 1 < Keys.Num())
+		{
+			for (float Fraction : { 0.25f, 0.5f, 0.75f })
+			{
+				const float Time = FMath::Lerp(Keys[i].Time, Keys[i + 1].Time, Fraction);
+				MaxError = FMath::Max(MaxError, FMath::Abs(Eval(Time) - Curve.Eval(Time)));
+			}
+		}
+	}
+	return MaxError;
+}
+
+float FCurviestCompressedCurve::EvalSegment(int KeyIdx, float InTime) const
+{
+	const float Time1 = GetKeyTime(KeyIdx);
+	const float Diff = GetKeyTime(KeyIdx + 1) - Time1;
+	const float P0 = GetKeyValue(KeyIdx);
+	const uint8 InterpMode = InterpModes[KeyIdx];
+	if (Diff <= 0.0f || InterpMode == RCIM_Constant)
+		return P0;
+
+	const float Alpha = (InTime - Time1) / Diff;
+	const float P3 = GetKeyValue(KeyIdx + 1);
+	if (InterpMode == RCIM_Linear)
+		return FMath::Lerp(P0, P3, Alpha);
+
+	const int Tangent = TangentIndex[KeyIdx];
+	const float OneThird = 1.0f / 3.0f;
+	const float P1 = P0 + (Tangents[Tangent] * Diff * OneThird);
+	const float P2 = P3 - (Tangents[Tangent + 1] * Diff * OneThird);
+	const float P01 = FMath::Lerp(P0, P1, Alpha);
+	const float P12 = FMath::Lerp(P1, P2, Alpha);
+	const float P23 = FMath::Lerp(P2, P3, Alpha);
+	return FMath::Lerp(FMath::Lerp(P01, P12, Alpha), FMath::Lerp(P12, P23, Alpha), Alpha);
+}
+
+void FCurviestCompressedCurve::RemapTime(float &InTime, float &CycleValueOffset) const
+{
+	// Mirrors FRichCurve's cycle and oscillate handling so cooked extrapolation is unchanged
+	const int NumKeys = Times.Num();
+	if (NumKeys < 2)
+		return;
+
+	const float MinTime = GetKeyTime(0);
+	const float MaxTime = GetKeyTime(NumKeys - 1);
+	const float Duration = MaxTime - MinTime;
+	const bool bBefore = InTime <= MinTime;
+	const bool bAfter = InTime >= MaxTime;
+	const uint8 Extrap = bBefore ? PreInfinityExtrap : bAfter ? PostInfinityExtrap : (uint8)RCCE_None;
+	if ((!bBefore && !bAfter) || Extrap == RCCE_Linear || Extrap == RCCE_Constant || Duration <= 0.0f)
+		return;
+
+	const float InitTime = InTime;
+	int CycleCount = 0;
+	if (InTime > MaxTime)
+	{
+		CycleCount = FMath::FloorToInt((MaxTime - InTime) / Duration);
+		InTime = InTime + Duration * CycleCount;
+	}
+	else if (InTime < MinTime)
+	{
+		CycleCount = FMath::FloorToInt((InTime - MinTime) / Duration);
+		InTime = InTime - Duration * CycleCount;
+	}
+	if (InTime == MaxTime && InitTime < MinTime)
+		InTime = MinTime;
+	if (InTime == MinTime && InitTime > MaxTime)
+		InTime = MaxTime;
+	CycleCount = FMath::Abs(CycleCount);
+
+	if (Extrap == RCCE_CycleWithOffset)
+	{
+		const float DV = bBefore ? GetKeyValue(0) - GetKeyValue(NumKeys - 1) : GetKeyValue(NumKeys - 1) - GetKeyValue(0);
+		CycleValueOffset = DV * CycleCount;
+	}
+	else if (Extrap == RCCE_Oscillate && CycleCount % 2 == 1)
+	{
+		InTime = MinTime + (MaxTime - InTime);
+	}
+}
+
+float FCurviestCompressedCurve::Eval(float InTime) const
+{
+	const int NumKeys = Times.Num();
+	if (NumKeys == 0)
+		return DefaultValue == MAX_flt ? 0.0f : DefaultValue;
+
+	float CycleValueOffset = 0.0f;
+	RemapTime(InTime, CycleValueOffset);
+
+	float Value;
+	if (NumKeys < 2 || InTime <= GetKeyTime(0))
+	{
+		Value = GetKeyValue(0);
+		if (PreInfinityExtrap == RCCE_Linear && NumKeys > 1)
+		{
+			const float DT = GetKeyTime(1) - GetKeyTime(0);
+			if (!FMath::IsNearlyZero(DT))
+				Value += (GetKeyValue(1) - Value) / DT * (InTime - GetKeyTime(0));
+		}
+	}
+	else if (InTime < GetKeyTime(NumKeys - 1))
+	{
+		// Search in quantized units so the loop compares straight against the stored times
+		const float QuantizedTime = TimeStep > 0.0f ? (InTime - TimeMin) / TimeStep : 0.0f;
+		int First = 1;
+		int Count = NumKeys - 2;
+		while (Count > 0)
+		{
+			const int Step = Count / 2;
+			const int Middle = First + Step;
+			if (QuantizedTime >= Times[Middle])
+			{
+				First = Middle + 1;
+				Count -= Step + 1;
+			}
+			else
+			{
+				Count = Step;
+			}
+		}
+		Value = EvalSegment(First - 1, InTime);
+	}
+	else
+	{
+		Value = GetKeyValue(NumKeys - 1);
+		if (PostInfinityExtrap == RCCE_Linear)
+		{
+			const float DT = GetKeyTime(NumKeys - 2) - GetKeyTime(NumKeys - 1);
+			if (!FMath::IsNearlyZero(DT))
+				Value += (GetKeyValue(NumKeys - 2) - Value) / DT * (InTime - GetKeyTime(NumKeys - 1));
+		}
+	}
+
+	return Value + CycleValueOffset;
+}
+
+bool FCurviestSegmentCurve::Build(const FRichCurve &Curve)
+{
+	Reset();
+
+	const TArray<FRichCurveKey> &Keys = Curve.Keys;
+	const int NumKeys = Keys.Num();
+	if (NumKeys < 2)
+		return false;
+
+	Times.SetNumUninitialized(NumKeys);
+	Coefficients.SetNumUninitialized((NumKeys - 1) * 4);
+	for (int i = 0; i < NumKeys - 1; i++)
+	{
+		const FRichCurveKey &Key1 = Keys[i];
+		const FRichCurveKey &Key2 = Keys[i + 1];
+		const float Diff = Key2.Time - Key1.Time;
+		float *Coefficient = &Coefficients[i * 4];
+		Times[i] = Key1.Time;
+
+		if (Diff <= 0.0f || Key1.InterpMode == RCIM_Constant)
+		{
+			Coefficient[0] = Coefficient[1] = Coefficient[2] = 0.0f;
+			Coefficient[3] = Key1.Value;
+		}
+		else if (Key1.InterpMode == RCIM_Linear)
+		{
+			Coefficient[0] = Coefficient[1] = 0.0f;
+			Coefficient[2] = (Key2.Value - Key1.Value) / Diff;
+			Coefficient[3] = Key1.Value;
+		}
+		else
+		{
+			const bool bKey1Weighted = Key1.TangentWeightMode == RCTWM_WeightedLeave || Key1.TangentWeightMode == RCTWM_WeightedBoth;
+			const bool bKey2Weighted = Key2.TangentWeightMode == RCTWM_WeightedArrive || Key2.TangentWeightMode == RCTWM_WeightedBoth;
+			if (bKey1Weighted || bKey2Weighted)
+			{
+				Reset();
+				return false;
+			}
+
+			// The Bezier EvalSegment walks with de Casteljau, expanded into powers of alpha and then of seconds
+			const float P0 = Key1.Value;
+			const float P1 = P0 + Key1.LeaveTangent * Diff / 3.0f;
+			const float P3 = Key2.Value;
+			const float P2 = P3 - Key2.ArriveTangent * Diff / 3.0f;
+			Coefficient[0] = (P3 - P0 + 3.0f * (P1 - P2)) / (Diff * Diff * Diff);
+			Coefficient[1] = 3.0f * (P0 - 2.0f * P1 + P2) / (Diff * Diff);
+			Coefficient[2] = Key1.LeaveTangent;
+			Coefficient[3] = P0;
+		}
+	}
+	Times[NumKeys - 1] = Keys[NumKeys - 1].Time;
+
+	return true;
+}
+
+float FCurviestSegmentCurve::EvalInRange(float InTime) const
+{
+	return EvalSegment(FCurviestCurveEval::FindSegment(Times.GetData(), Times.Num(), InTime), InTime);
+}
+
+float FCurviestSegmentCurve::EvalInRange(float InTime, FCurviestEvalCursor &Cursor) const
+{
+	const int NumTimes = Times.Num();
+
+	// Same walk as FCurviestCurveEval::EvalWithCursor, whose segments index the same keys
+	int Segment = Cursor.Segment;
+	if (Segment >= 0 && Segment < NumTimes - 1 && Times[Segment] <= InTime)
+	{
+		for (int Scan = 0; Scan < FCurviestCurveEval::MaxForwardScan && InTime >= Times[Segment + 1]; Scan++)
+			Segment++;
+
+		if (InTime >= Times[Segment + 1])
+			Segment = FCurviestCurveEval::FindSegment(Times.GetData(), NumTimes, InTime);
+	}
+	else
+	{
+		Segment = FCurviestCurveEval::FindSegment(Times.GetData(), NumTimes, InTime);
+	}
+	Cursor.Segment = Segment;
+
+	return EvalSegment(Segment, InTime);
+}
+
+// Assign sorted entries to tree nodes in order, so an in-order walk of the tree visits them sorted
+static void FillEytzinger(const TArray<FRichCurveKey> &Keys, TArray<float> &Times, TArray<int> &Segments, int Node, int &NextSorted)
+{
+	if (Node >= Times.Num())
+		return;
+
+	FillEytzinger(Keys, Times, Segments, Node * 2, NextSorted);
+	Times[Node] = Keys[NextSorted + 1].Time;
+	Segments[Node] = NextSorted;
+	NextSorted++;
+	FillEytzinger(Keys, Times, Segments, Node * 2 + 1, NextSorted);
+}
+
+bool FCurviestKeySearchIndex::Build(const FRichCurve &Curve)
+{
+	Reset();
+
+	const int NumKeys = Curve.Keys.Num();
+	if (NumKeys < 3)
+		return false;
+
+	// Same upper bound range as FindSegment, keys 1 to Num - 2. Node 0 is unused.
+	const int NumNodes = NumKeys - 2;
+	Times.SetNumUninitialized(NumNodes + 1);
+	Segments.SetNumUninitialized(NumNodes + 1);
+	Times[0] = 0.0f;
+	Segments[0] = NumNodes;
+
+	int NextSorted = 0;
+	FillEytzinger(Curve.Keys, Times, Segments, 1, NextSorted);
+	return true;
+}
+
+int FCurviestKeySearchIndex::FindSegment(float InTime) const
+{
+	const float *TimeData = Times.GetData();
+	const uint32 NumNodes = (uint32)Times.Num() - 1;
+
+	// Descend right while the node's key is at or before InTime. The sixteen descendants four levels down
+	// start at Node * 16 and fill one cache line, so fetching it now hides the miss four steps later.
+	uint32 Node = 1;
+	while (Node <= NumNodes)
+	{
+		FPlatformMisc::Prefetch(TimeData + FMath::Min(Node * 16, NumNodes));
+		Node = Node * 2 + (InTime >= TimeData[Node] ? 1 : 0);
+	}
+
+	// Undo the trailing right turns and the final left one to get the first node after InTime. Node 0 means
+	// every key is at or before it, which Segments[0] covers.
+	Node >>= FMath::CountTrailingZeros(~Node) + 1;
+	return Segments[Node];
+}
+
+void FCurviestSharedTimeAxis::Build(TArrayView<const int> InCurves, TArrayView<const FCurviestSegmentCurve> CurveSegments)
+{
+	check(InCurves.Num() == CurveSegments.Num() && CurveSegments.Num() > 0);
+
+	Times = CurveSegments[0].Times;
+	Curves = TArray<int>(InCurves.GetData(), InCurves.Num());
+
+	const int NumCurves = Curves.Num();
+	const int NumSegments = Times.Num() - 1;
+	Coefficients.SetNumUninitialized(NumSegments * 4 * NumCurves);
+	for (int Segment = 0; Segment < NumSegments; Segment++)
+	{
+		for (int Power = 0; Power < 4; Power++)
+		{
+			float *Block = &Coefficients[(Segment * 4 + Power) * NumCurves];
+			for (int Curve = 0; Curve < NumCurves; Curve++)
+				Block[Curve] = CurveSegments[Curve].Coefficients[Segment * 4 + Power];
+		}
+	}
+}
+
+int FCurviestSharedTimeAxis::FindSegment(float InTime) const
+{
+	if (Times.Num() < 2 || InTime < Times[0] || InTime >= Times.Last())
+		return INDEX_NONE;
+	return FCurviestCurveEval::FindSegment(Times.GetData(), Times.Num(), InTime);
+}
+
+void FCurviestSharedTimeAxis::EvalSegment(int Segment, float InTime, int FirstCurve, int NumCurves, float *ValuesOut) const
+{
+	const int Stride = Curves.Num();
+	const float Offset = InTime - Times[Segment];
+	const float *Cubic = &Coefficients[Segment * 4 * Stride + FirstCurve];
+	const float *Quadratic = Cubic + Stride;
+	const float *Linear = Quadratic + Stride;
+	const float *Constant = Linear + Stride;
+
+	// Every curve reads from contiguous blocks, so this loop vectorizes
+	for (int Curve = 0; Curve < NumCurves; Curve++)
+		ValuesOut[Curve] = ((Cubic[Curve] * Offset + Quadratic[Curve]) * Offset + Linear[Curve]) * Offset + Constant[Curve];
+}
+
+FCurviestCurvePool &FCurviestCurvePool::Get()
+{
+	static FCurviestCurvePool Pool;
+	return Pool;
+}
+
+FCurviestCurvePool::FCurvePtr FCurviestCurvePool::Share(FRichCurve &&Curve, uint64 Hash)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	// Compare the keys too, a matching hash alone isn't proof. Entries whose curves are gone are dropped on the way.
+	for (auto It = Curves.CreateKeyIterator(Hash); It; ++It)
+	{
+		FCurvePtr Pooled = It.Value().Pin();
+		if (!Pooled.IsValid())
+			It.RemoveCurrent();
+		else if (*Pooled == Curve)
+			return Pooled;
+	}
+
+	FCurvePtr Pooled = MakeShared<FRichCurve, ESPMode::ThreadSafe>(MoveTemp(Curve));
+	Curves.Add(Hash, Pooled);
+	return Pooled;
+}
+
+void FCurviestCurvePool::GetStats(int &NumCurvesOut, SIZE_T &PooledBytesOut, SIZE_T &ReferencedBytesOut) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	NumCurvesOut = 0;
+	PooledBytesOut = ReferencedBytesOut = 0;
+	for (const auto &Entry : Curves)
+	{
+		FCurvePtr Pooled = Entry.Value.Pin();
+		if (!Pooled.IsValid())
+			continue;
+
+		// Not counting the reference held by Pooled itself
+		const SIZE_T KeyBytes = Pooled->Keys.GetAllocatedSize();
+		NumCurvesOut++;
+		PooledBytesOut += KeyBytes;
+		ReferencedBytesOut += KeyBytes * (Pooled.GetSharedReferenceCount() - 1);
+	}
+}
+
+// One per thread that has pinned a snapshot. Never freed, and reused once their thread exits.
+struct FCurviestHazardSlot
+{
+	std::atomic<const FCurviestSnapshot*> Pointer { nullptr };
+	std::atomic<bool> bInUse { true };
+	FCurviestHazardSlot *Next = nullptr;
+};
+
+static std::atomic<FCurviestHazardSlot*> GHazardSlots { nullptr };
+
+// Claims a slot for the thread it belongs to and releases it when the thread exits
+struct FCurviestThreadHazard
+{
+	FCurviestHazardSlot *Slot = nullptr;
+
+	FCurviestThreadHazard()
+	{
+		for (FCurviestHazardSlot *It = GHazardSlots.load(std::memory_order_acquire); It; It = It->Next)
+		{
+			bool bInUse = false;
+			if (It->bInUse.compare_exchange_strong(bInUse, true))
+			{
+				Slot = It;
+				return;
+			}
+		}
+
+		// Cache line aligned, so no two threads' slots share a line
+		Slot = new (FMemory::Malloc(sizeof(FCurviestHazardSlot), PLATFORM_CACHE_LINE_SIZE)) FCurviestHazardSlot();
+		Slot->Next = GHazardSlots.load(std::memory_order_relaxed);
+		while (!GHazardSlots.compare_exchange_weak(Slot->Next, Slot, std::memory_order_release, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	~FCurviestThreadHazard()
+	{
+		Slot->Pointer.store(nullptr);
+		Slot->bInUse.store(false, std::memory_order_release);
+	}
+};
+
+std::atomic<const FCurviestSnapshot*> &FCurviestSnapshot::GetThreadHazard()
+{
+	thread_local FCurviestThreadHazard ThreadHazard;
+	return ThreadHazard.Slot->Pointer;
+}
+
+// Snapshots replaced while readers may still pin them, with the asset or instance they were replaced on
+struct FCurviestRetiredSnapshot
+{
+	const UObject *Owner;
+	TUniquePtr<const FCurviestSnapshot> Snapshot;
+};
+
+static FCriticalSection GRetiredSnapshotsLock;
+static TArray<FCurviestRetiredSnapshot> GRetiredSnapshots;
+
+// Caller holds GRetiredSnapshotsLock
+static void ReclaimRetiredSnapshots()
+{
+	if (GRetiredSnapshots.Num() == 0)
+		return;
+
+	// Hazards are read before pin counts. A reader that cleared its hazard raised the pin count first, and one that
+	// sets it from now on finds the pointer replaced when it checks again, since retired snapshots are unreachable.
+	TArray<const FCurviestSnapshot*, TInlineAllocator<32>> Hazards;
+	for (FCurviestHazardSlot *It = GHazardSlots.load(std::memory_order_acquire); It; It = It->Next)
+	{
+		if (const FCurviestSnapshot *Hazard = It->Pointer.load())
+			Hazards.Add(Hazard);
+	}
+
+	GRetiredSnapshots.RemoveAll([&Hazards](const FCurviestRetiredSnapshot &Retired)
+	{
+		return !Hazards.Contains(Retired.Snapshot.Get()) && Retired.Snapshot->PinCount.load() == 0;
+	});
+}
+
+void FCurviestSnapshot::Retire(const FCurviestSnapshot *Snapshot, const UObject *Owner)
+{
+	FScopeLock Lock(&GRetiredSnapshotsLock);
+	GRetiredSnapshots.Add({ Owner, TUniquePtr<const FCurviestSnapshot>(Snapshot) });
+
+	// Also here and not only at the end of the frame, so commandlets and cooks that never tick free them too
+	ReclaimRetiredSnapshots();
+}
+
+void FCurviestSnapshot::ReclaimRetired()
+{
+	FScopeLock Lock(&GRetiredSnapshotsLock);
+	ReclaimRetiredSnapshots();
+}
+
+SIZE_T FCurviestSnapshot::GetRetiredSize(const UObject *Owner)
+{
+	FScopeLock Lock(&GRetiredSnapshotsLock);
+
+	SIZE_T Bytes = 0;
+	for (const FCurviestRetiredSnapshot &Retired : GRetiredSnapshots)
+	{
+		if (Retired.Owner == Owner)
+			Bytes += Retired.Snapshot->GetAllocatedSize();
+	}
+	return Bytes;
+}
+
+void FCurviestSnapshot::ForgetOwner(const UObject *Owner)
+{
+	FScopeLock Lock(&GRetiredSnapshotsLock);
+	for (FCurviestRetiredSnapshot &Retired : GRetiredSnapshots)
+	{
+		if (Retired.Owner == Owner)
+			Retired.Owner = nullptr;
+	}
+}
+
+float FCurviestCurveEval::EvalWithCursor(const FRichCurve &Curve, float InTime, FCurviestEvalCursor &Cursor)
+{
+	const TArray<FRichCurveKey> &Keys = Curve.Keys;
+	const int NumKeys = Keys.Num();
+
+	// Extrapolation and single key curves don't search, let the engine handle them
+	if (NumKeys < 2 || InTime <= Keys[0].Time || InTime >= Keys[NumKeys - 1].Time)
+		return Curve.Eval(InTime);
+
+	int Segment = Cursor.Segment;
+	if (Segment >= 0 && Segment < NumKeys - 1 && Keys[Segment].Time <= InTime)
+	{
+		// InTime is before the last key, so this can't run off the end
+		for (int Scan = 0; Scan < MaxForwardScan && InTime >= Keys[Segment + 1].Time; Scan++)
+			Segment++;
+
+		if (InTime >= Keys[Segment + 1].Time)
+			Segment = FindSegment(Keys, InTime);
+	}
+	else
+	{
+		// First use, time went backwards or the keys changed under us
+		Segment = FindSegment(Keys, InTime);
+	}
+	Cursor.Segment = Segment;
+
+	float Value;
+	if (EvalSegment(Keys[Segment], Keys[Segment + 1], InTime, Value))
+		return Value;
+	return Curve.Eval(InTime);
+}
+
+int FCurviestCurveEval::FindSegment(const TArray<FRichCurveKey> &Keys, float InTime)
+{
+	// Upper bound over [1, Num - 1], same as FRichCurve::Eval
+	int First = 1;
+	int Count = Keys.Num() - 2;
+	while (Count > 0)
+	{
+		const int Step = Count / 2;
+		const int Middle = First + Step;
+		if (InTime >= Keys[Middle].Time)
+		{
+			First = Middle + 1;
+			Count -= Step + 1;
+		}
+		else
+		{
+			Count = Step;
+		}
+	}
+	return First - 1;
+}
+
+int FCurviestCurveEval::FindSegment(const float *Times, int NumTimes, float InTime)
+{
+	// Upper bound over [1, Num - 1], halving the same range length every step so the compare becomes a select
+	int Base = 1;
+	int Count = NumTimes - 2;
+	while (Count > 1)
+	{
+		const int Half = Count / 2;
+		Base = InTime >= Times[Base + Half] ? Base + Half : Base;
+		Count -= Half;
+	}
+	return (Count > 0 && InTime >= Times[Base] ? Base + 1 : Base) - 1;
+}
+
+bool FCurviestCurveEval::EvalSegment(const FRichCurveKey &Key1, const FRichCurveKey &Key2, float InTime, float &ValueOut)
+{
+	const float Diff = Key2.Time - Key1.Time;
+	if (Diff <= 0.0f || Key1.InterpMode == RCIM_Constant)
+	{
+		ValueOut = Key1.Value;
+		return true;
+	}
+
+	const float Alpha = (InTime - Key1.Time) / Diff;
+	const float P0 = Key1.Value;
+	const float P3 = Key2.Value;
+	if (Key1.InterpMode == RCIM_Linear)
+	{
+		ValueOut = FMath::Lerp(P0, P3, Alpha);
+		return true;
+	}
+
+	const bool bKey1Weighted = Key1.TangentWeightMode == RCTWM_WeightedLeave || Key1.TangentWeightMode == RCTWM_WeightedBoth;
+	const bool bKey2Weighted = Key2.TangentWeightMode == RCTWM_WeightedArrive || Key2.TangentWeightMode == RCTWM_WeightedBoth;
+	if (bKey1Weighted || bKey2Weighted)
+		return false;
+
+	// Same de Casteljau steps as the engine so results match to the bit
+	const float OneThird = 1.0f / 3.0f;
+	const float P1 = P0 + (Key1.LeaveTangent * Diff * OneThird);
+	const float P2 = P3 - (Key2.ArriveTangent * Diff * OneThird);
+	const float P01 = FMath::Lerp(P0, P1, Alpha);
+	const float P12 = FMath::Lerp(P1, P2, Alpha);
+	const float P23 = FMath::Lerp(P2, P3, Alpha);
+	const float P012 = FMath::Lerp(P01, P12, Alpha);
+	const float P123 = FMath::Lerp(P12, P23, Alpha);
+	ValueOut = FMath::Lerp(P012, P123, Alpha);
+	return true;
+}
+
+uint64 FCurviestCurveEval::HashCurve(const FRichCurve &Curve)
+{
+	const uint8 Extrap[2] = { (uint8)Curve.PreInfinityExtrap, (uint8)Curve.PostInfinityExtrap };
+	uint64 Hash = CityHash64WithSeed((const char*)Extrap, sizeof(Extrap), Curve.Keys.Num());
+	Hash = CityHash64WithSeed((const char*)&Curve.DefaultValue, sizeof(Curve.DefaultValue), Hash);
+
+	// Field by field, since the padding after the modes isn't initialized
+	for (const FRichCurveKey &Key : Curve.Keys)
+	{
+		const uint8 Modes[3] = { (uint8)Key.InterpMode, (uint8)Key.TangentMode, (uint8)Key.TangentWeightMode };
+		const float Values[6] = { Key.Time, Key.Value, Key.ArriveTangent, Key.ArriveTangentWeight, Key.LeaveTangent, Key.LeaveTangentWeight };
+		Hash = CityHash64WithSeed((const char*)Modes, sizeof(Modes), Hash);
+		Hash = CityHash64WithSeed((const char*)Values, sizeof(Values), Hash);
+	}
+	return Hash;
+}
+
+template<typename T>
+static uint64 HashArray(const TArray<T> &Array, uint64 Hash)
+{
+	return CityHash64WithSeed((const char*)Array.GetData(), Array.Num() * sizeof(T), Hash + Array.Num());
+}
+
+uint64 FCurviestCurveEval::HashCurve(const FCurviestCompressedCurve &Curve)
+{
+	const float Header[5] = { Curve.TimeMin, Curve.TimeStep, Curve.ValueMin, Curve.ValueStep, Curve.DefaultValue };
+	const uint8 Extrap[2] = { Curve.PreInfinityExtrap, Curve.PostInfinityExtrap };
+	uint64 Hash = CityHash64((const char*)Header, sizeof(Header));
+	Hash = CityHash64WithSeed((const char*)Extrap, sizeof(Extrap), Hash);
+	Hash = HashArray(Curve.Times, Hash);
+	Hash = HashArray(Curve.Values, Hash);
+	Hash = HashArray(Curve.InterpModes, Hash);
+	Hash = HashArray(Curve.TangentIndex, Hash);
+	return HashArray(Curve.Tangents, Hash);
+}
+
+void FCurviestCurveEval::FindSegments(const TArray<FRichCurveKey> &Keys, const float *InTimes, int *SegmentsOut)
+{
+	const FRichCurveKey *KeyData = Keys.GetData();
+
+	// Upper bound over [1, Num - 1] like FindSegment, but every lane halves the same range length each step
+	// so the loads for all lanes are independent and the compares become selects
+	int Base[NumLanes];
+	for (int Lane = 0; Lane < NumLanes; Lane++)
+		Base[Lane] = 1;
+
+	int Count = Keys.Num() - 2;
+	while (Count > 1)
+	{
+		const int Half = Count / 2;
+		for (int Lane = 0; Lane < NumLanes; Lane++)
+			Base[Lane] = InTimes[Lane] >= KeyData[Base[Lane] + Half].Time ? Base[Lane] + Half : Base[Lane];
+		Count -= Half;
+	}
+
+	for (int Lane = 0; Lane < NumLanes; Lane++)
+	{
+		const int UpperBound = Count > 0 && InTimes[Lane] >= KeyData[Base[Lane]].Time ? Base[Lane] + 1 : Base[Lane];
+		SegmentsOut[Lane] = UpperBound - 1;
+	}
+}
+
+void FCurviestCurveEval::FindSegments(const float *Times, int NumTimes, const float *InTimes, int *SegmentsOut)
+{
+	int Base[NumLanes];
+	for (int Lane = 0; Lane < NumLanes; Lane++)
+		Base[Lane] = 1;
+
+	int Count = NumTimes - 2;
+	while (Count > 1)
+	{
+		const int Half = Count / 2;
+		for (int Lane = 0; Lane < NumLanes; Lane++)
+			Base[Lane] = InTimes[Lane] >= Times[Base[Lane] + Half] ? Base[Lane] + Half : Base[Lane];
+		Count -= Half;
+	}
+
+	for (int Lane = 0; Lane < NumLanes; Lane++)
+	{
+		const int UpperBound = Count > 0 && InTimes[Lane] >= Times[Base[Lane]] ? Base[Lane] + 1 : Base[Lane];
+		SegmentsOut[Lane] = UpperBound - 1;
+	}
+}
+
+// A + Alpha * (B - A) as separate operations, so every lane rounds exactly like FMath::Lerp
+static FORCEINLINE FCurviestVector CurviestVectorLerp(const FCurviestVector &A, const FCurviestVector &B, const FCurviestVector &Alpha)
+{
+	return VectorAdd(A, VectorMultiply(Alpha, VectorSubtract(B, A)));
+}
+
+void FCurviestCurveEval::EvalMany(const FRichCurve &Curve, TArrayView<const float> Times, TArrayView<float> ValuesOut)
+{
+	const TArray<FRichCurveKey> &Keys = Curve.Keys;
+	const int NumKeys = Keys.Num();
+	const int NumValues = FMath::Min(Times.Num(), ValuesOut.Num());
+
+	if (NumKeys < 2)
+	{
+		for (int i = 0; i < NumValues; i++)
+			ValuesOut[i] = Curve.Eval(Times[i]);
+		return;
+	}
+
+	const float FirstKeyTime = Keys[0].Time;
+	const float LastKeyTime = Keys[NumKeys - 1].Time;
+	const float OneThird = 1.0f / 3.0f;
+
+	enum class ELaneMode : uint8
+	{
+		Engine,
+		Linear,
+		Cubic,
+	};
+
+	int i = 0;
+	for (; i + NumLanes <= NumValues; i += NumLanes)
+	{
+		MS_ALIGN(16) float Time[NumLanes] GCC_ALIGN(16);
+		MS_ALIGN(16) float Start[NumLanes] GCC_ALIGN(16);
+		MS_ALIGN(16) float Diff[NumLanes] GCC_ALIGN(16);
+		MS_ALIGN(16) float P0[NumLanes] GCC_ALIGN(16);
+		MS_ALIGN(16) float P1[NumLanes] GCC_ALIGN(16);
+		MS_ALIGN(16) float P2[NumLanes] GCC_ALIGN(16);
+		MS_ALIGN(16) float P3[NumLanes] GCC_ALIGN(16);
+		ELaneMode Mode[NumLanes];
+
+		for (int Lane = 0; Lane < NumLanes; Lane++)
+			Time[Lane] = Times[i + Lane];
+
+		int Segment[NumLanes];
+		FindSegments(Keys, Time, Segment);
+
+		// Gather the segment of each lane. Constant segments become a flat cubic, anything the vector path
+		// can't reproduce exactly is left to the engine.
+		for (int Lane = 0; Lane < NumLanes; Lane++)
+		{
+			const float T = Time[Lane];
+			const FRichCurveKey &Key1 = Keys[Segment[Lane]];
+			const FRichCurveKey &Key2 = Keys[Segment[Lane] + 1];
+			const float SegmentDiff = Key2.Time - Key1.Time;
+
+			Start[Lane] = Key1.Time;
+			Diff[Lane] = SegmentDiff;
+			P0[Lane] = Key1.Value;
+			P3[Lane] = Key2.Value;
+
+			const bool bKey1Weighted = Key1.TangentWeightMode == RCTWM_WeightedLeave || Key1.TangentWeightMode == RCTWM_WeightedBoth;
+			const bool bKey2Weighted = Key2.TangentWeightMode == RCTWM_WeightedArrive || Key2.TangentWeightMode == RCTWM_WeightedBoth;
+			const bool bCubic = SegmentDiff > 0.0f && Key1.InterpMode != RCIM_Constant && Key1.InterpMode != RCIM_Linear;
+			if (T <= FirstKeyTime || T >= LastKeyTime || (bCubic && (bKey1Weighted || bKey2Weighted)))
+			{
+				Mode[Lane] = ELaneMode::Engine;
+				Start[Lane] = T;
+				Diff[Lane] = 1.0f;
+				P1[Lane] = P2[Lane] = 0.0f;
+			}
+			else if (SegmentDiff <= 0.0f || Key1.InterpMode == RCIM_Constant)
+			{
+				Mode[Lane] = ELaneMode::Cubic;
+				Start[Lane] = T;
+				Diff[Lane] = 1.0f;
+				P1[Lane] = P2[Lane] = P3[Lane] = Key1.Value;
+			}
+			else if (Key1.InterpMode == RCIM_Linear)
+			{
+				Mode[Lane] = ELaneMode::Linear;
+				P1[Lane] = P2[Lane] = 0.0f;
+			}
+			else
+			{
+				Mode[Lane] = ELaneMode::Cubic;
+				P1[Lane] = Key1.Value + (Key1.LeaveTangent * SegmentDiff * OneThird);
+				P2[Lane] = Key2.Value - (Key2.ArriveTangent * SegmentDiff * OneThird);
+			}
+		}
+
+		// Same steps as EvalSegment, four lanes at a time
+		const FCurviestVector VecP0 = VectorLoadAligned(P0);
+		const FCurviestVector VecP1 = VectorLoadAligned(P1);
+		const FCurviestVector VecP2 = VectorLoadAligned(P2);
+		const FCurviestVector VecP3 = VectorLoadAligned(P3);
+		const FCurviestVector Alpha = VectorDivide(VectorSubtract(VectorLoadAligned(Time), VectorLoadAligned(Start)), VectorLoadAligned(Diff));
+
+		const FCurviestVector Linear = CurviestVectorLerp(VecP0, VecP3, Alpha);
+
+		const FCurviestVector P01 = CurviestVectorLerp(VecP0, VecP1, Alpha);
+		const FCurviestVector P12 = CurviestVectorLerp(VecP1, VecP2, Alpha);
+		const FCurviestVector P23 = CurviestVectorLerp(VecP2, VecP3, Alpha);
+		const FCurviestVector P012 = CurviestVectorLerp(P01, P12, Alpha);
+		const FCurviestVector P123 = CurviestVectorLerp(P12, P23, Alpha);
+		const FCurviestVector Cubic = CurviestVectorLerp(P012, P123, Alpha);
+
+		MS_ALIGN(16) float LinearValues[NumLanes] GCC_ALIGN(16);
+		MS_ALIGN(16) float CubicValues[NumLanes] GCC_ALIGN(16);
+		VectorStoreAligned(Linear, LinearValues);
+		VectorStoreAligned(Cubic, CubicValues);
+
+		for (int Lane = 0; Lane < NumLanes; Lane++)
+		{
+			switch (Mode[Lane])
+			{
+			case ELaneMode::Linear:
+				ValuesOut[i + Lane] = LinearValues[Lane];
+				break;
+			case ELaneMode::Cubic:
+				ValuesOut[i + Lane] = CubicValues[Lane];
+				break;
+			default:
+				ValuesOut[i + Lane] = Curve.Eval(Time[Lane]);
+				break;
+			}
+		}
+	}
+
+	// Leftover times that don't fill a register
+	for (; i < NumValues; i++)
+	{
+		const float T = Times[i];
+		if (T > FirstKeyTime && T < LastKeyTime)
+		{
+			const int Segment = FindSegment(Keys, T);
+			if (EvalSegment(Keys[Segment], Keys[Segment + 1], T, ValuesOut[i]))
+				continue;
+		}
+		ValuesOut[i] = Curve.Eval(T);
+	}
+}
+
+void FCurviestCurveEval::AccumulateWeighted(TArrayView<float> Sum, TArrayView<float> WeightSum, const float *Values, const float *Mask, float Weight)
+{
+	const int Num = FMath::Min(Sum.Num(), WeightSum.Num());
+	float *SumData = Sum.GetData();
+	float *WeightSumData = WeightSum.GetData();
+	const FCurviestVector VecWeight = VectorSetFloat1(Weight);
+
+	int i = 0;
+	for (; i + NumLanes <= Num; i += NumLanes)
+	{
+		VectorStore(VectorAdd(VectorLoad(SumData + i), VectorMultiply(VectorLoad(Values + i), VecWeight)), SumData + i);
+		VectorStore(VectorAdd(VectorLoad(WeightSumData + i), VectorMultiply(VectorLoad(Mask + i), VecWeight)), WeightSumData + i);
+	}
+
+	for (; i < Num; i++)
+	{
+		SumData[i] += Values[i] * Weight;
+		WeightSumData[i] += Mask[i] * Weight;
+	}
+}
+
+void FCurviestCurveEval::NormalizeWeighted(TArrayView<float> Sum, TArrayView<const float> WeightSum)
+{
+	const int Num = FMath::Min(Sum.Num(), WeightSum.Num());
+	float *SumData = Sum.GetData();
+	const float *WeightSumData = WeightSum.GetData();
+	const FCurviestVector Zero = VectorZero();
+
+	int i = 0;
+	for (; i + NumLanes <= Num; i += NumLanes)
+	{
+		// Lanes with no weight divide by zero, but the select throws those away
+		const FCurviestVector VecWeightSum = VectorLoad(WeightSumData + i);
+		const FCurviestVector Normalized = VectorDivide(VectorLoad(SumData + i), VecWeightSum);
+		VectorStore(VectorSelect(VectorCompareNE(VecWeightSum, Zero), Normalized, Zero), SumData + i);
+	}
+
+	for (; i < Num; i++)
+		SumData[i] = WeightSumData[i] != 0.0f ? SumData[i] / WeightSumData[i] : 0.0f;
+}
@@ -0,0 +1,302 @@
+// Copyright 2019 Skyler Clark. All Rights Reserved.
+
+#include "CurviestCurveInstance.h"
+#include "CurviestCurve.h"
+
+SIZE_T FCurviestInstanceSnapshot::GetAllocatedSize() const
+{
+	// Override keys belong to the instance, the snapshot only references them
+	return sizeof(*this) + Overrides.GetAllocatedSize() + MergedSlots.GetAllocatedSize();
+}
+
+UCurviestCurveInstance::~UCurviestCurveInstance()
+{
+	if (const FCurviestInstanceSnapshot *Current = Snapshot.exchange(nullptr))
+		FCurviestSnapshot::Retire(Current, nullptr);
+	FCurviestSnapshot::ForgetOwner(this);
+}
+
+void UCurviestCurveInstance::SetBase(UCurveCurviest *InBase)
+{
+	Base = InBase;
+	RefreshMergedSlots();
+}
+
+void UCurviestCurveInstance::SetValueOverride(FGameplayTag IdentifierTag, float Value)
+{
+	FCurviestCurveOverride &Override = FindOrAddOverride(IdentifierTag);
+	Override.Curve.Reset();
+	Override.SharedCurve.Reset();
+	Override.ValueScale = 0.0f;
+	Override.ValueOffset = Value;
+	RefreshMergedSlots();
+}
+
+void UCurviestCurveInstance::SetValueScaleOverride(FGameplayTag IdentifierTag, float ValueScale, float ValueOffset)
+{
+	FCurviestCurveOverride &Override = FindOrAddOverride(IdentifierTag);
+	Override.ValueScale = ValueScale;
+	Override.ValueOffset = ValueOffset;
+	RefreshMergedSlots();
+}
+
+void UCurviestCurveInstance::SetTimeScaleOverride(FGameplayTag IdentifierTag, float TimeScale)
+{
+	FCurviestCurveOverride &Override = FindOrAddOverride(IdentifierTag);
+	Override.TimeScale = TimeScale;
+	RefreshMergedSlots();
+}
+
+void UCurviestCurveInstance::ClearOverride(FGameplayTag IdentifierTag)
+{
+	Overrides.RemoveAll([IdentifierTag](const FCurviestCurveOverride &Override) { return Override.IdentifierTag == IdentifierTag; });
+	RefreshMergedSlots();
+}
+
+void UCurviestCurveInstance::ClearAllOverrides()
+{
+	Overrides.Empty();
+	RefreshMergedSlots();
+}
+
+FRichCurve *UCurviestCurveInstance::EditCurve(FGameplayTag IdentifierTag)
+{
+	if (!Base)
+		return nullptr;
+
+	const FCurviestLookupPin Lookups = Base->GetLookups();
+	const FCurviestEvaluationSlot *Slot = Lookups->FindTagged(IdentifierTag, false);
+	if (!Slot)
+		return nullptr;
+
+	// Copy on first write, so instances that never edit keys don't hold a curve. Cooked builds may have dropped the
+	// loaded keys after sharing them, so editing those again starts from the shared copy.
+	FCurviestCurveOverride &Override = FindOrAddOverride(IdentifierTag);
+	if (Override.Curve.GetNumKeys() == 0)
+		Override.Curve = Override.SharedCurve.IsValid() ? *Override.SharedCurve : Slot->Owner->CurveData[Slot->Index].GetCurve();
+	return &Override.Curve;
+}
+
+FCurviestCurveOverride *UCurviestCurveInstance::FindOverride(FGameplayTag IdentifierTag)
+{
+	return Overrides.FindByPredicate([IdentifierTag](const FCurviestCurveOverride &Override) { return Override.IdentifierTag == IdentifierTag; });
+}
+
+FCurviestCurveOverride &UCurviestCurveInstance::FindOrAddOverride(FGameplayTag IdentifierTag)
+{
+	if (FCurviestCurveOverride *Override = FindOverride(IdentifierTag))
+		return *Override;
+
+	FCurviestCurveOverride &Override = Overrides.AddDefaulted_GetRef();
+	Override.IdentifierTag = IdentifierTag;
+	return Override;
+}
+
+float UCurviestCurveInstance::EvalOverride(const FCurviestPublishedOverride &Override, const FCurviestEvaluationSlot &Slot, float InTime) const
+{
+	const float Time = InTime * Override.TimeScale;
+	const float Value = Override.Curve.IsValid() ? Override.Curve->Eval(Time) : Slot.Eval(Time);
+	return Value * Override.ValueScale + Override.ValueOffset;
+}
+
+const FCurviestPublishedOverride *UCurviestCurveInstance::FindSlotOverride(const FCurviestInstanceSnapshot &Current, const FCurviestLookupSnapshot &Lookups, const FCurviestEvaluationSlot &Slot)
+{
+	if (Current.Epoch == Lookups.Epoch)
+		return Slot.SlotIndex != INDEX_NONE ? Current.FindSlotOverride(Slot.SlotIndex) : nullptr;
+
+	// Until the game thread republishes for the new layout, match on the tag of the slot, as RefreshMergedSlots would
+	return Slot.SlotIndex != INDEX_NONE && Slot.IdentifierTag.IsValid() ? Current.FindOverride(Slot.IdentifierTag) : nullptr;
+}
+
+bool UCurviestCurveInstance::GetFloatValueFromTaggedCurve(FGameplayTag IdentifierTag, float InTime, float &ValueOut, bool bAllowParamLookup) const
+{
+	// Overrides only patch what the base resolves, so a tag it doesn't have stays missing. With parent tag fallbacks
+	// the override of the slot the base falls back to applies, the same one EvaluateAllCurves applies to that slot.
+	if (!Base)
+		return false;
+	const FCurviestLookupPin Lookups = Base->GetLookups();
+	const FCurviestEvaluationSlot *Slot = Lookups->FindTagged(IdentifierTag, bAllowParamLookup);
+	if (!Slot)
+		return false;
+
+	const FCurviestInstancePin Current(Snapshot);
+	const FCurviestPublishedOverride *Override = Current.IsValid() ? FindSlotOverride(*Current, *Lookups, *Slot) : nullptr;
+	ValueOut = Override ? EvalOverride(*Override, *Slot, InTime) : Slot->Eval(InTime);
+	return true;
+}
+
+bool UCurviestCurveInstance::GetFloatValueFromTaggedParam(FGameplayTag IdentifierTag, float &ValueOut) const
+{
+	if (!Base)
+		return false;
+	const FCurviestLookupPin Lookups = Base->GetLookups();
+	const FCurviestEvaluationSlot *Slot = Lookups->ResolvedParamByTag.Find(IdentifierTag);
+	if (!Slot)
+		return false;
+
+	const FCurviestInstancePin Current(Snapshot);
+	const FCurviestPublishedOverride *Override = Current.IsValid() ? FindSlotOverride(*Current, *Lookups, *Slot) : nullptr;
+	const float BaseValue = Slot->Eval(0.0f);
+	ValueOut = Override ? BaseValue * Override->ValueScale + Override->ValueOffset : BaseValue;
+	return true;
+}
+
+void UCurviestCurveInstance::EvaluateAllCurves(float InTime, TArrayView<float> ValuesOut) const
+{
+	if (!Base)
+		return;
+
+	Base->EvaluateAllCurves(InTime, ValuesOut);
+
+	FCurviestInstancePin Current(Snapshot);
+	if (!Current.IsValid() || Current->Overrides.Num() == 0)
+		return;
+
+	// After the base layout changes the slots are merged again here, but only on the game thread, which is
+	// where the setters publish too. Other threads match overrides by tag until then.
+	if (Current->Epoch != UCurveCurviest::LayoutEpoch.load(std::memory_order_acquire) && IsInGameThread())
+	{
+		Publish(TArray<FCurviestPublishedOverride>(Current->Overrides));
+		Current = FCurviestInstancePin(Snapshot);
+	}
+
+	const FCurviestLookupPin Lookups = Base->GetLookups();
+	const int NumSlots = FMath::Min(ValuesOut.Num(), Lookups->EvaluationSlots.Num());
+	if (Current->Epoch == Lookups->Epoch)
+	{
+		for (const TPair<int, int> &Merged : Current->MergedSlots)
+		{
+			if (Merged.Key < NumSlots)
+				ValuesOut[Merged.Key] = EvalOverride(Current->Overrides[Merged.Value], Lookups->EvaluationSlots[Merged.Key], InTime);
+		}
+		return;
+	}
+
+	for (int i = 0; i < NumSlots; i++)
+	{
+		const FCurviestEvaluationSlot &Slot = Lookups->EvaluationSlots[i];
+		if (const FCurviestPublishedOverride *Override = Slot.IdentifierTag.IsValid() ? Current->FindOverride(Slot.IdentifierTag) : nullptr)
+			ValuesOut[i] = EvalOverride(*Override, Slot, InTime);
+	}
+}
+
+void UCurviestCurveInstance::EvaluateAllCurvesToArray(float InTime, TArray<float> &ValuesOut) const
+{
+	ValuesOut.SetNumUninitialized(Base ? Base->GetNumEvaluationSlots() : 0);
+	EvaluateAllCurves(InTime, ValuesOut);
+}
+
+void UCurviestCurveInstance::RefreshMergedSlots()
+{
+	// Curve stays the authoritative copy. Snapshots share an immutable copy of it, made again only when the keys
+	// changed, so republishing unchanged overrides copies references only.
+	TArray<FCurviestPublishedOverride> Published;
+	Published.Reserve(Overrides.Num());
+	for (FCurviestCurveOverride &Override : Overrides)
+	{
+		if (Override.Curve.GetNumKeys() > 0)
+		{
+			if (!Override.SharedCurve.IsValid() || !(*Override.SharedCurve == Override.Curve))
+				Override.SharedCurve = MakeShared<FRichCurve, ESPMode::ThreadSafe>(Override.Curve);
+		}
+		else if (!FPlatformProperties::RequiresCookedData())
+		{
+			// Cooked builds drop the loaded keys once shared, see PostLoad, so only here does no keys mean none
+			Override.SharedCurve.Reset();
+		}
+		Published.Add({ Override.IdentifierTag, Override.SharedCurve, Override.TimeScale, Override.ValueScale, Override.ValueOffset });
+	}
+
+	Publish(MoveTemp(Published));
+}
+
+void UCurviestCurveInstance::Publish(TArray<FCurviestPublishedOverride> &&PublishedOverrides) const
+{
+	check(IsInGameThread());
+
+	// Built whole and swapped in, so readers on other threads only ever see a finished snapshot
+	FCurviestInstanceSnapshot *NewSnapshot = new FCurviestInstanceSnapshot();
+	NewSnapshot->Overrides = MoveTemp(PublishedOverrides);
+	if (Base)
+	{
+		TMap<FGameplayTag, int> OverrideByTag;
+		for (int i = 0; i < NewSnapshot->Overrides.Num(); i++)
+			OverrideByTag.Add(NewSnapshot->Overrides[i].IdentifierTag, i);
+
+		// Visited in slot order, so MergedSlots comes out sorted
+		const FCurviestLookupPin Lookups = Base->GetLookups();
+		for (int i = 0; i < Lookups->EvaluationSlots.Num(); i++)
+		{
+			const FGameplayTag &Tag = Lookups->EvaluationSlots[i].IdentifierTag;
+			const int *OverrideIdx = Tag.IsValid() ? OverrideByTag.Find(Tag) : nullptr;
+			if (OverrideIdx)
+				NewSnapshot->MergedSlots.Emplace(i, *OverrideIdx);
+		}
+		NewSnapshot->Epoch = Lookups->Epoch;
+	}
+
+	if (const FCurviestInstanceSnapshot *OldSnapshot = Snapshot.exchange(NewSnapshot, std::memory_order_acq_rel))
+		FCurviestSnapshot::Retire(OldSnapshot, this);
+}
+
+void UCurviestCurveInstance::Serialize(FArchive &Ar)
+{
+	// Cooked builds may only have the shared copy of loaded keys, so put it back while they are written
+	TArray<int> RestoredCurves;
+	if (Ar.IsSaving())
+	{
+		for (int i = 0; i < Overrides.Num(); i++)
+		{
+			if (Overrides[i].Curve.GetNumKeys() == 0 && Overrides[i].SharedCurve.IsValid())
+			{
+				Overrides[i].Curve = *Overrides[i].SharedCurve;
+				RestoredCurves.Add(i);
+			}
+		}
+	}
+
+	Super::Serialize(Ar);
+
+	for (int i : RestoredCurves)
+		Overrides[i].Curve = FRichCurve();
+
+	// The loaded properties are authoritative until RefreshMergedSlots publishes them again
+	if (Ar.IsLoading())
+	{
+		for (FCurviestCurveOverride &Override : Overrides)
+			Override.SharedCurve.Reset();
+	}
+}
+
+void UCurviestCurveInstance::PostLoad()
+{
+	Super::PostLoad();
+
+	RefreshMergedSlots();
+
+	// Nothing edits loaded keys in cooked builds until EditCurve copies them back, so the shared copy is enough
+	if (FPlatformProperties::RequiresCookedData())
+	{
+		for (FCurviestCurveOverride &Override : Overrides)
+		{
+			if (Override.SharedCurve.IsValid())
+				Override.Curve = FRichCurve();
+		}
+	}
+}
+
+#if WITH_EDITOR
+void UCurviestCurveInstance::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	RefreshMergedSlots();
+}
+
+void UCurviestCurveInstance::PostEditChangeProperty(struct FPropertyChangedEvent& e)
+{
+	Super::PostEditChangeProperty(e);
+
+	RefreshMergedSlots();
+}
+#endif
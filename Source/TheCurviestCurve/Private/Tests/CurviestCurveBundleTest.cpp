@@ -0,0 +1,197 @@
+// Copyright 2019 Skyler Clark. All Rights Reserved.
+
+#include "CurviestCurveBundleExport.h"
+#include "CurviestCurveBundle.h"
+#include "CurviestCurve.h"
+#include "GameplayTagsManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "UObject/Package.h"
+
+// Editor only, since the test tags it registers would change the tag tree and net index hash of dev game builds
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+static const TCHAR *BundleTestTagNames[] =
+{
+	TEXT("CurviestTest.Linear"),
+	TEXT("CurviestTest.Constant"),
+	TEXT("CurviestTest.Cubic"),
+	TEXT("CurviestTest.CubicUser"),
+	TEXT("CurviestTest.Stance"),
+	TEXT("CurviestTest.Stance.Crouch"),
+	TEXT("CurviestTest.Stance.Crouch.Speed"),
+	TEXT("CurviestTest.Stance.Prone"),
+	TEXT("CurviestTest.Param"),
+	TEXT("CurviestTest.Shadowed"),
+};
+
+// Native tags can only be added while the tag manager starts up, so sessions that run this test pass
+// -CurviestTestTags. Every other session keeps its tag tree free of them.
+static FDelegateHandle BundleTestTagsHandle = UGameplayTagsManager::OnLastChanceToAddNativeTags().AddLambda([]()
+{
+	if (!FParse::Param(FCommandLine::Get(), TEXT("CurviestTestTags")))
+		return;
+
+	for (const TCHAR *TagName : BundleTestTagNames)
+		UGameplayTagsManager::Get().AddNativeGameplayTag(TagName);
+});
+
+static void AddBundleTestCurve(UCurveCurviest *Asset, const TCHAR *TagName, ERichCurveInterpMode InterpMode, ERichCurveTangentMode TangentMode,
+	ERichCurveExtrapolation PreExtrap, ERichCurveExtrapolation PostExtrap, float ValueScale)
+{
+	FCurviestCurveData &Data = Asset->CurveData.AddDefaulted_GetRef();
+	Data.Name = FName(TagName);
+	Data.IdentifierTag = FGameplayTag::RequestGameplayTag(TagName);
+
+	FRichCurve &Curve = Data.Curve;
+	const float Values[] = { 0.0f, 2.0f, -1.0f, 0.5f };
+	for (int i = 0; i < UE_ARRAY_COUNT(Values); i++)
+	{
+		const FKeyHandle Key = Curve.AddKey(i * 0.75f, Values[i] * ValueScale);
+		Curve.SetKeyInterpMode(Key, InterpMode);
+		Curve.SetKeyTangentMode(Key, TangentMode);
+		if (TangentMode == RCTM_User)
+		{
+			FRichCurveKey &RichKey = Curve.GetKey(Key);
+			RichKey.ArriveTangent = 1.5f - i;
+			RichKey.LeaveTangent = i * 0.25f - 2.0f;
+		}
+	}
+	Curve.PreInfinityExtrap = PreExtrap;
+	Curve.PostInfinityExtrap = PostExtrap;
+	Curve.AutoSetTangents();
+}
+
+static void AddBundleTestParam(UCurveCurviest *Asset, const TCHAR *TagName, float Value)
+{
+	FCurviestCurveFloatParam &Param = Asset->Params.AddDefaulted_GetRef();
+	Param.IdentifierTag = FGameplayTag::RequestGameplayTag(TagName);
+	Param.Value = Value;
+}
+
+static void RebuildBundleTestAsset(UCurveCurviest *Asset)
+{
+	Asset->RebuildSegmentCurves();
+	Asset->RebuildSharedTimeAxes();
+	Asset->RebuildBakedCurves();
+	Asset->RebuildLookupMaps();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCurviestCurveBundleCrossCheckTest, "Plugins.TheCurviestCurve.Bundle.CrossCheck",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FCurviestCurveBundleCrossCheckTest::RunTest(const FString &Parameters)
+{
+	TArray<FGameplayTag> Tags;
+	for (const TCHAR *TagName : BundleTestTagNames)
+	{
+		const FGameplayTag Tag = FGameplayTag::RequestGameplayTag(TagName, false);
+		if (!Tag.IsValid())
+		{
+			// Skipped rather than failed, since most sessions leave the test tags out on purpose
+			AddWarning(FString::Printf(TEXT("Skipped: %s isn't registered, run the editor with -CurviestTestTags to add the test tags"), TagName));
+			return true;
+		}
+		Tags.Add(Tag);
+	}
+	// The root is on no asset and no tag falls back to it, so neither lookup may find it
+	Tags.Add(FGameplayTag::RequestGameplayTag(TEXT("CurviestTest")));
+
+	// Every interp and extrapolation mode, on the parent evaluated from keys
+	UCurveCurviest *Parent = NewObject<UCurveCurviest>(GetTransientPackage());
+	Parent->CurveData.Reset();
+	AddBundleTestCurve(Parent, TEXT("CurviestTest.Linear"), RCIM_Linear, RCTM_Auto, RCCE_Cycle, RCCE_CycleWithOffset, 1.0f);
+	AddBundleTestCurve(Parent, TEXT("CurviestTest.Constant"), RCIM_Constant, RCTM_Auto, RCCE_Oscillate, RCCE_Linear, 1.0f);
+	AddBundleTestCurve(Parent, TEXT("CurviestTest.Cubic"), RCIM_Cubic, RCTM_Auto, RCCE_Linear, RCCE_Constant, 1.0f);
+	AddBundleTestCurve(Parent, TEXT("CurviestTest.CubicUser"), RCIM_Cubic, RCTM_User, RCCE_None, RCCE_Oscillate, 1.0f);
+	AddBundleTestCurve(Parent, TEXT("CurviestTest.Stance"), RCIM_Cubic, RCTM_Auto, RCCE_CycleWithOffset, RCCE_Cycle, 3.0f);
+	AddBundleTestCurve(Parent, TEXT("CurviestTest.Stance.Crouch"), RCIM_Linear, RCTM_Auto, RCCE_Constant, RCCE_Linear, -2.0f);
+	AddBundleTestCurve(Parent, TEXT("CurviestTest.Shadowed"), RCIM_Cubic, RCTM_Auto, RCCE_Constant, RCCE_Constant, 1.0f);
+	AddBundleTestParam(Parent, TEXT("CurviestTest.Param"), 4.25f);
+	RebuildBundleTestAsset(Parent);
+
+	// A child falling back to parent tags through cached segments, shadowing one parent curve with a param
+	UCurveCurviest *Child = NewObject<UCurveCurviest>(GetTransientPackage());
+	Child->CurveData.Reset();
+	Child->Parent = Parent;
+	Child->bFallBackToParentTags = true;
+	Child->bCacheSegmentCoefficients = true;
+	AddBundleTestCurve(Child, TEXT("CurviestTest.Cubic"), RCIM_Cubic, RCTM_User, RCCE_Oscillate, RCCE_CycleWithOffset, 0.5f);
+	AddBundleTestParam(Child, TEXT("CurviestTest.Shadowed"), -1.5f);
+	RebuildBundleTestAsset(Child);
+
+	// The same through baked tables
+	UCurveCurviest *BakedChild = NewObject<UCurveCurviest>(GetTransientPackage());
+	BakedChild->CurveData.Reset();
+	BakedChild->Parent = Parent;
+	BakedChild->bFallBackToParentTags = true;
+	BakedChild->bBakeCurves = true;
+	AddBundleTestCurve(BakedChild, TEXT("CurviestTest.Stance.Prone"), RCIM_Cubic, RCTM_Auto, RCCE_Linear, RCCE_Oscillate, 2.0f);
+	RebuildBundleTestAsset(BakedChild);
+
+	const UCurveCurviest *Assets[] = { Parent, Child, BakedChild };
+	FCurviestCurveBundleExporter Exporter;
+	for (const UCurveCurviest *Asset : Assets)
+		Exporter.AddAsset(Asset);
+
+	TArray<uint8> Bytes;
+	TestEqual(TEXT("Unsupported curves"), Exporter.Write(Bytes), 0);
+
+	CurviestBundle::FBundleView View;
+	if (!TestTrue(TEXT("Reader opens the exported bundle"), View.Open(Bytes.GetData(), Bytes.Num())))
+		return false;
+
+	// Keys, midpoints and well outside the key range on both sides
+	TArray<float> Times;
+	for (int i = -24; i <= 32; i++)
+		Times.Add(i * 0.1875f);
+	Times.Append({ -100.3f, -7.0f, 9.6f, 250.25f });
+
+	int NumSamples = 0;
+	int NumFallbackSamples = 0;
+	int NumMismatches = 0;
+	for (const UCurveCurviest *Asset : Assets)
+	{
+		const CurviestBundle::FAsset *BundleAsset = View.FindAsset(TCHAR_TO_UTF8(*Asset->GetPathName()));
+		if (!TestNotNull(TEXT("Bundle asset"), BundleAsset))
+			continue;
+
+		for (const bool bAllowParamLookup : { false, true })
+		{
+			FCurviestLookupPin Lookups;
+			const TArrayView<const FGameplayTag> ListedTags = Asset->GetCurveIdentifierTagsView(Lookups, bAllowParamLookup);
+			for (const FGameplayTag &Tag : Tags)
+			{
+				const FTCHARToUTF8 TagName(*Tag.ToString());
+				for (const float Time : Times)
+				{
+					float Expected = 0.0f;
+					float Actual = 0.0f;
+					const bool bExpectedFound = Asset->GetFloatValueFromTaggedCurve(Tag, Time, Expected, bAllowParamLookup);
+					const bool bActualFound = View.Eval(*BundleAsset, TagName.Get(), Time, Actual, bAllowParamLookup);
+					NumSamples++;
+					if (bExpectedFound && !ListedTags.Contains(Tag))
+						NumFallbackSamples++;
+
+					if (bExpectedFound != bActualFound || (bExpectedFound && FMemory::Memcmp(&Expected, &Actual, sizeof(float)) != 0))
+					{
+						if (NumMismatches++ < 16)
+						{
+							AddError(FString::Printf(TEXT("%s %s at %g%s is %s, bundle gives %s"), *Asset->GetName(), *Tag.ToString(), Time,
+								bAllowParamLookup ? TEXT(" with params") : TEXT(""),
+								bExpectedFound ? *FString::SanitizeFloat(Expected) : TEXT("nothing"), bActualFound ? *FString::SanitizeFloat(Actual) : TEXT("nothing")));
+						}
+					}
+				}
+			}
+		}
+	}
+
+	TestTrue(TEXT("Samples compared"), NumSamples > 0);
+	TestTrue(TEXT("Samples found through parent tags"), NumFallbackSamples > 0);
+	TestEqual(TEXT("Mismatches"), NumMismatches, 0);
+	return true;
+}
+
+#endif
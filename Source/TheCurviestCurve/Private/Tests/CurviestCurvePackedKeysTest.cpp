@@ -0,0 +1,123 @@
+// Copyright 2019 Skyler Clark. All Rights Reserved.
+
+#include "CurviestCurve.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Keys set directly rather than through AddKey, so tangents and weights are exactly what each case asks for
+static void AddPackedKeysTestCurve(UCurveCurviest *Asset, const TCHAR *Name, int NumKeys, bool bTangents, bool bWeights)
+{
+	FCurviestCurveData &Data = Asset->CurveData.AddDefaulted_GetRef();
+	Data.Name = FName(Name);
+
+	const ERichCurveInterpMode InterpModes[] = { RCIM_Cubic, RCIM_Linear, RCIM_Constant };
+	for (int i = 0; i < NumKeys; i++)
+	{
+		FRichCurveKey &Key = Data.Curve.Keys.AddDefaulted_GetRef();
+		Key.Time = i * 0.5f - 1.0f;
+		Key.Value = FMath::Sin(i * 1.3f) * 4.0f;
+		Key.InterpMode = InterpModes[i % UE_ARRAY_COUNT(InterpModes)];
+		Key.TangentMode = i % 2 ? RCTM_User : RCTM_Break;
+		Key.ArriveTangent = bTangents ? 0.75f - i : 0.0f;
+		Key.LeaveTangent = bTangents ? i * 0.25f - 2.0f : 0.0f;
+		Key.TangentWeightMode = bWeights ? (i % 2 ? RCTWM_WeightedBoth : RCTWM_WeightedArrive) : RCTWM_WeightedNone;
+		Key.ArriveTangentWeight = bWeights ? 0.5f + i * 0.125f : 0.0f;
+		Key.LeaveTangentWeight = bWeights ? 1.5f - i * 0.0625f : 0.0f;
+	}
+}
+
+// Save Source to memory, as a package would with bPackKeys or with every key in the tagged properties, and load it into a new asset
+static UCurveCurviest *RoundTripPackedKeysTestAsset(UCurveCurviest *Source, bool bPackKeys)
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes, bPackKeys);
+	FObjectAndNameAsStringProxyArchive WriteArchive(Writer, false);
+	Source->Serialize(WriteArchive);
+
+	UCurveCurviest *Target = NewObject<UCurveCurviest>(GetTransientPackage());
+	Target->CurveData.Reset();
+
+	FMemoryReader Reader(Bytes, bPackKeys);
+	Reader.SetCustomVersions(WriteArchive.GetCustomVersions());
+	FObjectAndNameAsStringProxyArchive ReadArchive(Reader, false);
+	Target->Serialize(ReadArchive);
+	return Reader.IsError() ? nullptr : Target;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCurviestCurvePackedKeysRoundTripTest, "Plugins.TheCurviestCurve.Serialize.PackedKeys",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FCurviestCurvePackedKeysRoundTripTest::RunTest(const FString &Parameters)
+{
+	// Each combination of the optional tangent and weight blocks, plus curves with too few keys to have segments
+	UCurveCurviest *Source = NewObject<UCurveCurviest>(GetTransientPackage());
+	Source->CurveData.Reset();
+	AddPackedKeysTestCurve(Source, TEXT("Plain"), 7, false, false);
+	AddPackedKeysTestCurve(Source, TEXT("Tangents"), 7, true, false);
+	AddPackedKeysTestCurve(Source, TEXT("Weights"), 7, false, true);
+	AddPackedKeysTestCurve(Source, TEXT("TangentsAndWeights"), 7, true, true);
+	AddPackedKeysTestCurve(Source, TEXT("OneKey"), 1, true, true);
+	AddPackedKeysTestCurve(Source, TEXT("NoKeys"), 0, false, false);
+
+	TArray<TArray<FRichCurveKey>> SourceKeys;
+	for (const FCurviestCurveData &Data : Source->CurveData)
+		SourceKeys.Add(Data.Curve.Keys);
+
+	for (bool bPackKeys : { false, true })
+	{
+		const TCHAR *Format = bPackKeys ? TEXT("packed") : TEXT("tagged");
+		UCurveCurviest *Target = RoundTripPackedKeysTestAsset(Source, bPackKeys);
+		if (!Target)
+		{
+			AddError(FString::Printf(TEXT("Loading %s keys failed"), Format));
+			continue;
+		}
+
+		// Saving swaps the keys out of the source while the properties are written, so they must be back after
+		for (int CurveIdx = 0; CurveIdx < SourceKeys.Num(); CurveIdx++)
+		{
+			if (Source->CurveData[CurveIdx].Curve.Keys != SourceKeys[CurveIdx])
+				AddError(FString::Printf(TEXT("Saving %s keys changed the source keys of %s"), Format, *Source->CurveData[CurveIdx].Name.ToString()));
+		}
+
+		if (!TestEqual(FString::Printf(TEXT("Curves loaded from %s keys"), Format), Target->CurveData.Num(), SourceKeys.Num()))
+			continue;
+
+		for (int CurveIdx = 0; CurveIdx < SourceKeys.Num(); CurveIdx++)
+		{
+			const FCurviestCurveData &Loaded = Target->CurveData[CurveIdx];
+			const TArray<FRichCurveKey> &Expected = SourceKeys[CurveIdx];
+			if (!TestEqual(FString::Printf(TEXT("%s keys of %s"), Format, *Loaded.Name.ToString()), Loaded.Curve.Keys.Num(), Expected.Num()))
+				continue;
+
+			for (int KeyIdx = 0; KeyIdx < Expected.Num(); KeyIdx++)
+			{
+				// Compared field by field so an unmatched mode or weight is reported, not just the key
+				const FRichCurveKey &Key = Loaded.Curve.Keys[KeyIdx];
+				const FRichCurveKey &ExpectedKey = Expected[KeyIdx];
+				const bool bMatches = Key.InterpMode == ExpectedKey.InterpMode && Key.TangentMode == ExpectedKey.TangentMode
+					&& Key.TangentWeightMode == ExpectedKey.TangentWeightMode && Key.Time == ExpectedKey.Time && Key.Value == ExpectedKey.Value
+					&& Key.ArriveTangent == ExpectedKey.ArriveTangent && Key.LeaveTangent == ExpectedKey.LeaveTangent
+					&& Key.ArriveTangentWeight == ExpectedKey.ArriveTangentWeight && Key.LeaveTangentWeight == ExpectedKey.LeaveTangentWeight;
+				if (!bMatches)
+				{
+					AddError(FString::Printf(TEXT("%s key %d of %s: loaded time %f value %f tangents %f %f weights %f %f modes %d %d %d, expected time %f value %f tangents %f %f weights %f %f modes %d %d %d"),
+						Format, KeyIdx, *Loaded.Name.ToString(),
+						Key.Time, Key.Value, Key.ArriveTangent, Key.LeaveTangent, Key.ArriveTangentWeight, Key.LeaveTangentWeight,
+						(int)Key.InterpMode, (int)Key.TangentMode, (int)Key.TangentWeightMode,
+						ExpectedKey.Time, ExpectedKey.Value, ExpectedKey.ArriveTangent, ExpectedKey.LeaveTangent, ExpectedKey.ArriveTangentWeight, ExpectedKey.LeaveTangentWeight,
+						(int)ExpectedKey.InterpMode, (int)ExpectedKey.TangentMode, (int)ExpectedKey.TangentWeightMode));
+				}
+			}
+		}
+	}
+
+	return !HasAnyErrors();
+}
+
+#endif
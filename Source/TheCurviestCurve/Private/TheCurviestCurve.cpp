@@ -1,20 +1,44 @@
-// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
-
-#include "TheCurviestCurve.h"
-
-#define LOCTEXT_NAMESPACE "FTheCurviestCurveModule"
-
-void FTheCurviestCurveModule::StartupModule()
-{
-	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
-}
-
-void FTheCurviestCurveModule::ShutdownModule()
-{
-	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
-	// we call this function before unloading the module.
-}
-
-#undef LOCTEXT_NAMESPACE
-	
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "TheCurviestCurve.h"
+#include "CurviestCurve.h"
+#include "GameplayTagsManager.h"
+#include "GameplayTagsModule.h"
+#include "Misc/CoreDelegates.h"
+
+#define LOCTEXT_NAMESPACE "FTheCurviestCurveModule"
+
+DEFINE_LOG_CATEGORY(LogCurviestCurve);
+
+void FTheCurviestCurveModule::StartupModule()
+{
+	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&FCurviestSnapshot::ReclaimRetired);
+
+	// Tags added at runtime, for example by plugins mounting, change what parent tag fallbacks resolve to and
+	// reassign tag net indices. Lookups on other threads only learn of it from the epoch bumped here.
+	TagTreeChangedRuntimeHandle = IGameplayTagsModule::OnGameplayTagTreeChanged.AddStatic(&UCurveCurviest::InvalidateLookups);
+
+#if WITH_EDITOR
+	// Tag net indices are reassigned when tags are added or removed in the editor
+	TagTreeChangedHandle = UGameplayTagsManager::OnEditorRefreshGameplayTagTree.AddStatic(&UCurveCurviest::InvalidateLookups);
+#endif
+}
+
+void FTheCurviestCurveModule::ShutdownModule()
+{
+	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
+	// we call this function before unloading the module.
+
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	IGameplayTagsModule::OnGameplayTagTreeChanged.Remove(TagTreeChangedRuntimeHandle);
+
+#if WITH_EDITOR
+	UGameplayTagsManager::OnEditorRefreshGameplayTagTree.Remove(TagTreeChangedHandle);
+#endif
+}
+
+#undef LOCTEXT_NAMESPACE
+	
 IMPLEMENT_MODULE(FTheCurviestCurveModule, TheCurviestCurve)
\ No newline at end of file
@@ -1,151 +1,914 @@
-// Copyright 2019 Skyler Clark. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "UObject/ObjectMacros.h"
-#include "Curves/RichCurve.h"
-#include "Curves/CurveBase.h"
-#include "Kismet/BlueprintFunctionLibrary.h"
-#include "GameplayTagContainer.h"
-#include "CurviestCurve.generated.h"
-
-UCLASS()
-class THECURVIESTCURVE_API UCurveCurviestBlueprintUtils : public UBlueprintFunctionLibrary
-{
-	GENERATED_BODY()
-public:
-	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Math|Curves", meta = (WorldContext = "WorldContextObject", BlueprintInternalUseOnly = "true"))
-	static float GetValueFromCurve(UCurveBase *Curve, FName Name, float InTime);
-
-	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Math|Curves", meta = (WorldContext = "WorldContextObject", BlueprintInternalUseOnly = "true"))
-	static float GetValueFromTaggedCurve(UCurveCurviest *Curve, FGameplayTag Tag, float InTime, bool bAllowParamLookup = true);
-
-};
-
-USTRUCT(BlueprintType)
-struct FCurviestCurveData
-{
-	GENERATED_BODY()
-
-public:
-	// Identifying Curve Name
-	UPROPERTY(EditAnywhere, Category = "Curviest")
-	FName Name;
-
-	UPROPERTY(EditAnywhere, Category = "Curviest")
-	FGameplayTag IdentifierTag;
-
-	UPROPERTY(EditAnywhere, Category = "Curviest")
-	FLinearColor Color;
-
-	UPROPERTY()
-	FRichCurve Curve;
-
-	FCurviestCurveData() 
-	{
-		this->Color = FLinearColor::White;
-	}
-	FCurviestCurveData(FName Name, FLinearColor Color)
-	{
-		this->Name = Name;
-		this->Color = Color;
-	}
-};
-
-USTRUCT(BlueprintType)
-struct FCurviestCurveFloatParam
-{
-	GENERATED_BODY()
-
-public:
-	UPROPERTY(EditAnywhere, Category = "Curviest")
-	FGameplayTag IdentifierTag;
-
-	UPROPERTY(EditAnywhere, Category = "Curviest")
-	float Value = 0.0f;
-};
-
-UCLASS(BlueprintType, collapsecategories, hidecategories = (FilePath))
-class THECURVIESTCURVE_API UCurveCurviest : public UCurveBase
-{
-	GENERATED_BODY()
-
-	DECLARE_MULTICAST_DELEGATE_OneParam(FOnCurveMapChanged, UCurveBase*);
-
-public:
-
-	UCurveCurviest();
-	~UCurveCurviest();
-
-	/*UFUNCTION(BlueprintCallable, Category = "Math|Curves")
-	TArray<FName> GetCurveNames() const {
-		return CurveNames.Array();
-	}*/
-
-	/** Evaluate this float curve at the specified time */
-	UFUNCTION(BlueprintCallable, Category = "Math|Curves")
-	float GetFloatValue(FName Name, float InTime) const;
-
-	UFUNCTION(BlueprintCallable, Category = "Math|Curves")
-	bool GetFloatValueFromNamedCurve(FName Name, float InTime, float &ValueOut) const;
-
-	UFUNCTION(BlueprintCallable, Category = "Math|Curves")
-	bool GetFloatValueFromTaggedCurve(FGameplayTag IdentifierTag, float InTime, float &ValueOut, bool bAllowParamLookup = true) const;
-
-	UFUNCTION(BlueprintCallable, Category = "Math|Curves")
-	bool GetFloatValueFromTaggedParam(FGameplayTag IdentifierTag, float &ValueOut) const;
-
-	UFUNCTION(BlueprintCallable, Category = "Math|Curves")
-	TArray<FGameplayTag> GetAllCurveIdentifierTags(bool bAllowParamLookup = true) const;
-	
-	UFUNCTION(BlueprintCallable, Category = "Math|Curves")
-	TArray<FGameplayTag> GetAllParamIdentifierTags() const;
-
-	// Begin FCurveOwnerInterface
-	virtual TArray<FRichCurveEditInfoConst> GetCurves() const override;
-	virtual TArray<FRichCurveEditInfo> GetCurves() override;
-
-	/** @return Color for this curve */
-	virtual FLinearColor GetCurveColor(FRichCurveEditInfo CurveInfo) const override;
-
-	/** Determine if Curve is the same */
-	bool operator == (const UCurveCurviest& Curve) const;
-
-	virtual bool IsValidCurve(FRichCurveEditInfo CurveInfo) override;
-
-#if WITH_EDITOR
-	void MakeCurveNameUnique(int CurveIdx);
-
-	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& e) override;
-
-	virtual void PreEditChange(class FEditPropertyChain& e) override;
-	virtual void PostEditChangeChainProperty(struct FPropertyChangedChainEvent& e) override;
-	//virtual void OnCurveChanged(const TArray<FRichCurveEditInfo>& ChangedCurveEditInfos) override;
-#endif
-
-#if WITH_EDITORONLY_DATA
-	FOnCurveMapChanged OnCurveMapChanged;
-#endif
-
-	UPROPERTY(EditAnywhere, Category = "Curviest")
-	UCurveCurviest *Parent = nullptr;
-
-	UPROPERTY(EditAnywhere, Category = "Curviest", meta = (NoResetToDefault))
-	TArray<FCurviestCurveData> CurveData;
-
-	UPROPERTY(EditAnywhere, Category = "Curviest", meta = (NoResetToDefault))
-	TArray<FCurviestCurveFloatParam> Params;
-
-	void RebuildLookupMaps();
-
-	bool bLookupsNeedRebuild = true;
-	TMap<FName, int> CurveLookupByName;
-	TMap<FGameplayTag, int> CurveLookupByTag;
-	TMap<FGameplayTag, int> ParamLookupByTag;
-
-protected:
-	int OldCurveCount;
-
-
-};
+// Copyright 2019 Skyler Clark. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "Curves/RichCurve.h"
+#include "Curves/CurveBase.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "GameplayTagContainer.h"
+#include "CurviestCurveEval.h"
+#include "Algo/BinarySearch.h"
+#include <atomic>
+#include "CurviestCurve.generated.h"
+
+/** Versions of the data UCurveCurviest writes after its tagged properties */
+struct FCurviestCurveCustomVersion
+{
+	enum Type
+	{
+		BeforeCustomVersionWasAdded = 0,
+
+		// Cooked assets may store keys as FCurviestCompressedCurve
+		CompressedKeys,
+
+		// Keys are stored in packed blocks after the tagged properties
+		PackedKeys,
+
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	THECURVIESTCURVE_API static const FGuid GUID;
+
+private:
+	FCurviestCurveCustomVersion() {}
+};
+
+class UCurveCurviest;
+
+/**
+ * The curves a Get Curve Values or Get Tagged Curve Values node reads, created by the Blueprint compiler and
+ * referenced from the generated code as an object literal so the list is never rebuilt or copied at runtime.
+ */
+UCLASS()
+class THECURVIESTCURVE_API UCurviestCurveValueList : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	TArray<FName> Names;
+
+	/** Used instead of Names when not empty */
+	UPROPERTY()
+	TArray<FGameplayTag> Tags;
+
+	UPROPERTY()
+	bool bAllowParamLookup = true;
+
+	/** Evaluation slot for each entry, resolved when the Blueprint compiled. INDEX_NONE where nothing was found. */
+	UPROPERTY()
+	TArray<int32> SlotIndices;
+
+	/** Layout hash of the asset SlotIndices were resolved against, or 0 if they weren't */
+	UPROPERTY()
+	uint64 LayoutHash = 0;
+
+	int Num() const { return Tags.Num() > 0 ? Tags.Num() : Names.Num(); }
+
+	/** Resolve every entry against Curve so any asset with the same layout can skip the hashed lookups */
+	void ResolveSlots(const UCurveCurviest *Curve);
+};
+
+UCLASS(meta = (BlueprintThreadSafe))
+class THECURVIESTCURVE_API UCurveCurviestBlueprintUtils : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+public:
+	/** Curviest, float, vector and linear color curves are read on any thread. Other curve classes give 0 off the game thread. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Math|Curves", meta = (WorldContext = "WorldContextObject", BlueprintInternalUseOnly = "true"))
+	static float GetValueFromCurve(UCurveBase *Curve, FName Name, float InTime);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Math|Curves", meta = (WorldContext = "WorldContextObject", BlueprintInternalUseOnly = "true"))
+	static float GetValueFromTaggedCurve(UCurveCurviest *Curve, FGameplayTag Tag, float InTime, bool bAllowParamLookup = true);
+
+	/** Values is resized to the list and only reallocates when it grows, so it should be storage the caller reuses */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Math|Curves", meta = (BlueprintInternalUseOnly = "true"))
+	static void GetValuesFromCurve(UCurveBase *Curve, UCurviestCurveValueList *ValueList, float InTime, TArray<float> &Values);
+
+	/** One entry of ValueList, so a pure node can give each output its own call and evaluate only what is read */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Math|Curves", meta = (BlueprintInternalUseOnly = "true"))
+	static float GetValueFromValueList(UCurveBase *Curve, UCurviestCurveValueList *ValueList, int32 Index, float InTime);
+
+	/** GetValuesFromCurve for nodes with exec pins, which run it once and keep Values between calls */
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves", meta = (BlueprintInternalUseOnly = "true"))
+	static void EvaluateValuesFromCurve(UCurveBase *Curve, UCurviestCurveValueList *ValueList, float InTime, UPARAM(ref) TArray<float> &Values);
+
+};
+
+USTRUCT(BlueprintType)
+struct FCurviestCurveData
+{
+	GENERATED_BODY()
+
+public:
+	// Identifying Curve Name
+	UPROPERTY(EditAnywhere, Category = "Curviest")
+	FName Name;
+
+	UPROPERTY(EditAnywhere, Category = "Curviest")
+	FGameplayTag IdentifierTag;
+
+#if WITH_EDITORONLY_DATA
+	UPROPERTY(EditAnywhere, Category = "Curviest")
+	FLinearColor Color;
+#endif
+
+	UPROPERTY()
+	FRichCurve Curve;
+
+	// Replaces the keys in Curve for cooked assets with key compression enabled
+	FCurviestCompressedCurve Compressed;
+
+	// Derived from the curve when the owning asset has baking enabled
+	FCurviestBakedCurve Baked;
+
+	// Derived from the curve when the owning asset caches segment coefficients
+	FCurviestSegmentCurve Segments;
+
+	// Derived from the curve when it has enough keys that a plain binary search misses cache
+	FCurviestKeySearchIndex SearchIndex;
+
+	// Index into the owning asset's shared time axes, INDEX_NONE if this curve's key times are its own
+	int SharedTimeAxis = INDEX_NONE;
+
+	// Identical keys pooled with other cooked assets, used instead of Curve whose keys are then emptied
+	FCurviestCurvePool::FCurvePtr SharedCurve;
+
+	// FCurviestCurveEval::HashCurve of the keys, kept current with them by the owning asset
+	uint64 ContentHash = 0;
+
+	/** The keys this curve evaluates, pooled or its own */
+	const FRichCurve &GetCurve() const
+	{
+		return SharedCurve.IsValid() ? *SharedCurve : Curve;
+	}
+
+	float Eval(float InTime) const
+	{
+		return Baked.Contains(InTime) ? Baked.EvalInRange(InTime) : EvalSource(InTime);
+	}
+
+	float Eval(float InTime, FCurviestEvalCursor &Cursor) const
+	{
+		if (Baked.Contains(InTime))
+			return Baked.EvalInRange(InTime);
+		if (Segments.Contains(InTime))
+			return Segments.EvalInRange(InTime, Cursor);
+		return Compressed.IsValid() ? Compressed.Eval(InTime) : FCurviestCurveEval::EvalWithCursor(GetCurve(), InTime, Cursor);
+	}
+
+	/** Evaluate at each of Times, writing min(Times.Num(), ValuesOut.Num()) values */
+	void EvalMany(TArrayView<const float> Times, TArrayView<float> ValuesOut) const
+	{
+		if (!Baked.IsValid() && !Segments.IsValid() && !Compressed.IsValid())
+		{
+			FCurviestCurveEval::EvalMany(GetCurve(), Times, ValuesOut);
+			return;
+		}
+
+		const int NumValues = FMath::Min(Times.Num(), ValuesOut.Num());
+		int i = 0;
+		if (Segments.IsValid())
+		{
+			// Search the segment times for a batch of samples at once, then evaluate each in the segment found
+			constexpr int NumLanes = FCurviestCurveEval::NumLanes;
+			for (; i + NumLanes <= NumValues; i += NumLanes)
+			{
+				int Segment[NumLanes];
+				FCurviestCurveEval::FindSegments(Segments.Times.GetData(), Segments.Times.Num(), Times.GetData() + i, Segment);
+				for (int Lane = 0; Lane < NumLanes; Lane++)
+				{
+					const float Time = Times[i + Lane];
+					if (Baked.Contains(Time))
+						ValuesOut[i + Lane] = Baked.EvalInRange(Time);
+					else
+						ValuesOut[i + Lane] = Segments.Contains(Time) ? Segments.EvalSegment(Segment[Lane], Time) : EvalSource(Time);
+				}
+			}
+		}
+
+		for (; i < NumValues; i++)
+			ValuesOut[i] = Eval(Times[i]);
+	}
+
+	/** Evaluate whichever key storage this curve has, ignoring any baked table */
+	float EvalSource(float InTime) const
+	{
+		if (Compressed.IsValid())
+			return Compressed.Eval(InTime);
+
+		if (SearchIndex.IsValid())
+		{
+			// Keys edited through GetCurves() keep the old index and segments until the next rebuild, so those are
+			// only trusted while they cover as many keys as the curve has now
+			const TArray<FRichCurveKey> &Keys = GetCurve().Keys;
+			if (SearchIndex.IsBuiltFor(Keys.Num()) && InTime >= Keys[0].Time && InTime < Keys.Last().Time)
+			{
+				const int Segment = SearchIndex.FindSegment(InTime);
+				if (Segments.IsBuiltFor(Keys.Num()))
+					return Segments.EvalSegment(Segment, InTime);
+
+				float Value;
+				if (FCurviestCurveEval::EvalSegment(Keys[Segment], Keys[Segment + 1], InTime, Value))
+					return Value;
+			}
+		}
+
+		return Segments.Contains(InTime) ? Segments.EvalInRange(InTime) : GetCurve().Eval(InTime);
+	}
+
+	/** Time of the first and last key, false if there are no keys */
+	bool GetKeyTimeRange(float &MinTimeOut, float &MaxTimeOut) const
+	{
+		if (Compressed.IsValid())
+		{
+			const int NumKeys = Compressed.GetNumKeys();
+			if (NumKeys == 0)
+				return false;
+			MinTimeOut = Compressed.GetKeyTime(0);
+			MaxTimeOut = Compressed.GetKeyTime(NumKeys - 1);
+			return true;
+		}
+
+		const TArray<FRichCurveKey> &Keys = GetCurve().Keys;
+		if (Keys.Num() == 0)
+			return false;
+		MinTimeOut = Keys[0].Time;
+		MaxTimeOut = Keys.Last().Time;
+		return true;
+	}
+
+	FCurviestCurveData() 
+	{
+#if WITH_EDITORONLY_DATA
+		this->Color = FLinearColor::White;
+#endif
+	}
+	FCurviestCurveData(FName Name, FLinearColor Color)
+	{
+		this->Name = Name;
+#if WITH_EDITORONLY_DATA
+		this->Color = Color;
+#endif
+	}
+};
+
+USTRUCT(BlueprintType)
+struct FCurviestCurveFloatParam
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, Category = "Curviest")
+	FGameplayTag IdentifierTag;
+
+	UPROPERTY(EditAnywhere, Category = "Curviest")
+	float Value = 0.0f;
+};
+
+/** A curve or param on a UCurveCurviest or one of its parents that a lookup resolved to */
+struct FCurviestEvaluationSlot
+{
+	// Dereferenced by Eval. Kept alive by the asset the slot was resolved on, which holds its parents, for as long as
+	// the slot's snapshot or LayoutEpoch is current; destroying any Curviest asset moves the epoch on.
+	const UCurveCurviest *Owner = nullptr;
+	int Index = INDEX_NONE;
+	bool bIsParam = false;
+	FGameplayTag IdentifierTag;
+
+	// Index into the snapshot's EvaluationSlots, or INDEX_NONE where another curve or param with the same tag shadows it there
+	int SlotIndex = INDEX_NONE;
+
+	bool IsSameSource(const FCurviestEvaluationSlot &Other) const
+	{
+		return Owner == Other.Owner && Index == Other.Index && bIsParam == Other.bIsParam;
+	}
+
+	float Eval(float InTime) const;
+	float Eval(float InTime, FCurviestEvalCursor &Cursor) const;
+	void EvalMany(TArrayView<const float> Times, TArrayView<float> ValuesOut) const;
+};
+
+/**
+ * A tag or name lookup resolved once against one UCurveCurviest, including its parent chain.
+ * Stays valid until any Curviest asset changes; after that it resolves again from its tag or name.
+ */
+USTRUCT(BlueprintType)
+struct FCurviestCurveHandle
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadOnly, Category = "Curviest")
+	FGameplayTag IdentifierTag;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Curviest")
+	FName Name;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Curviest")
+	bool bAllowParamLookup = true;
+
+	// Asset resolved on. Weak, since handles outlive assets; Slot is only read through a live asset at the same Generation.
+	TWeakObjectPtr<const UCurveCurviest> Asset;
+	uint32 Generation = 0;
+	FCurviestEvaluationSlot Slot;
+
+	bool IsResolved() const { return Slot.Owner != nullptr; }
+};
+
+/** How EvaluateQuery combines the values of every slot a query matches */
+UENUM(BlueprintType)
+enum class ECurviestQueryAggregate : uint8
+{
+	Sum,
+	Min,
+	Max,
+	Product,
+	Average,
+};
+
+/**
+ * An FGameplayTagQuery compiled against one UCurveCurviest into the evaluation slots whose tags match it.
+ * Like a handle it stays valid until any Curviest asset changes, then compiles again from Query.
+ */
+USTRUCT(BlueprintType)
+struct FCurviestCurveQuery
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Curviest")
+	FGameplayTagQuery Query;
+
+	// Include params and not just curves
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Curviest")
+	bool bAllowParamLookup = true;
+
+	// Asset compiled against, weak since queries outlive assets
+	TWeakObjectPtr<const UCurveCurviest> Asset;
+	uint32 Generation = 0;
+
+	// Matching indices into the asset's evaluation slots, in slot order
+	TArray<int> SlotIndices;
+};
+
+/**
+ * Several UCurveCurviest assets blended by weight into one set of slots covering the tags of all of them.
+ * Compiled once into a slot table, which stays valid until Assets or any Curviest asset changes.
+ */
+USTRUCT(BlueprintType)
+struct FCurviestCurveBlend
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Curviest")
+	TArray<UCurveCurviest*> Assets;
+
+	// Include params and not just curves
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Curviest")
+	bool bAllowParamLookup = true;
+
+	// Assets this was compiled against, weak since Assets may change or be collected after compiling
+	TArray<TWeakObjectPtr<const UCurveCurviest>> CompiledAssets;
+	uint32 Generation = 0;
+
+	// Union of the identifier tags of every asset, in the order blended values are written
+	TArray<FGameplayTag> SlotTags;
+
+	// Number of evaluation slots of each asset
+	TArray<int> SourceSlotCounts;
+
+	// SlotTags.Num() entries per asset: the asset's evaluation slot for each tag, or its slot count where it lacks
+	// the tag so the lookup lands on a trailing zero
+	TArray<int> SourceSlots;
+
+	// Same layout as SourceSlots, 1 where the asset has the tag and 0 where it doesn't
+	TArray<float> SourceMasks;
+
+	// Scratch space for EvaluateBlend, sized when compiling so evaluation never allocates. This is also why a
+	// blend can't be evaluated from several threads at once.
+	TArray<float> WeightSum;
+	TArray<float> Gathered;
+	TArray<float> AssetValues;
+};
+
+/**
+ * Resolved slots by gameplay tag net index, an array read for assets that opt in. Covers only the range of net
+ * indices the asset uses, and switches to a sorted list when those are too spread out for a table.
+ */
+struct THECURVIESTCURVE_API FCurviestTagNetIndexTable
+{
+	// Net index of the first entry in Dense
+	FGameplayTagNetIndex FirstNetIndex = 0;
+
+	// Index into Slots for each net index from FirstNetIndex, INDEX_NONE where the tag isn't used. Empty when sparse.
+	TArray<int> Dense;
+
+	// Sorted net index of each entry in Slots, only searched when Dense is empty
+	TArray<FGameplayTagNetIndex> Sparse;
+
+	TArray<FCurviestEvaluationSlot> Slots;
+
+	/** Index Resolved, and every tag in ParentFallbacks under the slot it falls back to. Game thread only. */
+	void Build(const TMap<FGameplayTag, FCurviestEvaluationSlot> &Resolved, const TMap<FGameplayTag, const FCurviestEvaluationSlot*> &ParentFallbacks);
+
+	const FCurviestEvaluationSlot *Find(FGameplayTagNetIndex NetIndex) const
+	{
+		if (Dense.Num() > 0)
+		{
+			const uint32 Offset = (uint32)NetIndex - (uint32)FirstNetIndex;
+			const int SlotIdx = Offset < (uint32)Dense.Num() ? Dense[Offset] : INDEX_NONE;
+			return SlotIdx != INDEX_NONE ? &Slots[SlotIdx] : nullptr;
+		}
+
+		const int SlotIdx = Algo::BinarySearch(Sparse, NetIndex);
+		return SlotIdx != INDEX_NONE ? &Slots[SlotIdx] : nullptr;
+	}
+
+	SIZE_T GetAllocatedSize() const { return Dense.GetAllocatedSize() + Sparse.GetAllocatedSize() + Slots.GetAllocatedSize(); }
+};
+
+/** A snapshot's resolved tag maps again by tag net index */
+struct FCurviestNetIndexTables
+{
+	FCurviestTagNetIndexTable ValueByNetIndex;
+	FCurviestTagNetIndexTable CurveByNetIndex;
+
+	// The tag manager's net index hash when these were built
+	uint32 NetIndexHash = 0;
+};
+
+/**
+ * Immutable lookup tables for a UCurveCurviest. Replaced as a whole when the asset changes, never modified in place.
+ * A replaced snapshot is freed once no FCurviestLookupPin holds it.
+ */
+struct FCurviestLookupSnapshot : public FCurviestSnapshot
+{
+	// Local to the owning asset
+	TMap<FName, int> CurveLookupByName;
+	TMap<FGameplayTag, int> CurveLookupByTag;
+	TMap<FGameplayTag, int> ParamLookupByTag;
+
+	// Flattened over the whole parent chain so a tagged lookup is one probe at any depth
+	TMap<FGameplayTag, FCurviestEvaluationSlot> ResolvedCurveByTag;
+	TMap<FGameplayTag, FCurviestEvaluationSlot> ResolvedParamByTag;
+	TMap<FGameplayTag, FCurviestEvaluationSlot> ResolvedValueByTag;
+
+	TArray<FCurviestEvaluationSlot> EvaluationSlots;
+
+	// The identifier tag of each evaluation slot as a container with its parent tags, built once for tag queries to match
+	TArray<FGameplayTagContainer> SlotTagContainers;
+
+	// Keys of the resolved tag maps, sorted by name for listing
+	TArray<FGameplayTag> CurveTags;
+	TArray<FGameplayTag> ParamTags;
+	TArray<FGameplayTag> ValueTags;
+
+	// Net index tables, only for assets with bDenseTagIndex set. Net indices can only be asked for on the game thread,
+	// so a snapshot built off the game thread is published without them and has them attached there afterwards,
+	// the one change made to a published snapshot. GetLookups compares their hash on the game thread, since indices
+	// are reassigned whenever tags are added. Without tables, net index lookups go through the tag on the game thread
+	// and find nothing elsewhere.
+	mutable std::atomic<const FCurviestNetIndexTables*> NetIndexTables { nullptr };
+
+	const FCurviestNetIndexTables *GetNetIndexTables() const { return NetIndexTables.load(std::memory_order_acquire); }
+
+	/** Build the net index tables and attach them if there are none yet. Game thread only. */
+	void AttachNetIndexTables() const;
+
+	virtual ~FCurviestLookupSnapshot() { delete NetIndexTables.load(std::memory_order_acquire); }
+
+	// Copied from the asset when the snapshot is built
+	bool bFallBackToParentTags = false;
+
+	/** Resolved slot for Tag, or with bFallBackToParentTags for its nearest ancestor tag that resolves */
+	const FCurviestEvaluationSlot *FindTagged(const FGameplayTag &Tag, bool bAllowParamLookup) const
+	{
+		const FCurviestEvaluationSlot *Slot = (bAllowParamLookup ? ResolvedValueByTag : ResolvedCurveByTag).Find(Tag);
+		return Slot || !bFallBackToParentTags ? Slot : FindParentTagged(Tag, bAllowParamLookup);
+	}
+
+	/** Nearest ancestor of Tag that resolves, from the fallbacks built with the snapshot */
+	const FCurviestEvaluationSlot *FindParentTagged(const FGameplayTag &Tag, bool bAllowParamLookup) const
+	{
+		const FCurviestEvaluationSlot *const *Slot = (bAllowParamLookup ? ParentFallbackValueByTag : ParentFallbackCurveByTag).Find(Tag);
+		return Slot ? *Slot : nullptr;
+	}
+
+	// With bFallBackToParentTags, every registered descendant of a resolved tag that doesn't resolve itself,
+	// mapped to its nearest resolved ancestor. Tags registered later bump the layout epoch and rebuild these.
+	TMap<FGameplayTag, const FCurviestEvaluationSlot*> ParentFallbackValueByTag;
+	TMap<FGameplayTag, const FCurviestEvaluationSlot*> ParentFallbackCurveByTag;
+
+	uint32 Epoch = 0;
+
+	// Hash of every name and tag in the parent chain. Unlike Epoch it is the same across sessions, so it
+	// can be saved with compiled Blueprints.
+	uint64 LayoutHash = 0;
+
+	virtual SIZE_T GetAllocatedSize() const override;
+};
+
+typedef TCurviestSnapshotPin<FCurviestLookupSnapshot> FCurviestLookupPin;
+
+/**
+ * Many named or tagged curves in one asset. The BlueprintThreadSafe getters may be called from any thread, each pinning
+ * the lookups it reads for the length of the call.
+ */
+UCLASS(BlueprintType, collapsecategories, hidecategories = (FilePath))
+class THECURVIESTCURVE_API UCurveCurviest : public UCurveBase
+{
+	GENERATED_BODY()
+
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnCurveMapChanged, UCurveBase*);
+
+public:
+
+	UCurveCurviest();
+	~UCurveCurviest();
+
+	virtual void BeginDestroy() override;
+
+	/*UFUNCTION(BlueprintCallable, Category = "Math|Curves")
+	TArray<FName> GetCurveNames() const {
+		return CurveNames.Array();
+	}*/
+
+	/** Evaluate this float curve at the specified time */
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves", meta = (BlueprintThreadSafe))
+	float GetFloatValue(FName Name, float InTime) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves", meta = (BlueprintThreadSafe))
+	bool GetFloatValueFromNamedCurve(FName Name, float InTime, float &ValueOut) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves", meta = (BlueprintThreadSafe))
+	bool GetFloatValueFromTaggedCurve(FGameplayTag IdentifierTag, float InTime, float &ValueOut, bool bAllowParamLookup = true) const;
+
+	/** Evaluate each named curve in Names with one lookup snapshot. Missing names write 0. */
+	void GetFloatValuesFromNamedCurves(TArrayView<const FName> Names, float InTime, TArrayView<float> ValuesOut) const;
+
+	/** Evaluate every entry in ValueList, reading its resolved slots directly if they match this asset's layout */
+	void GetFloatValuesFromValueList(const UCurviestCurveValueList &ValueList, float InTime, TArrayView<float> ValuesOut) const;
+
+	/** Evaluate entry Index of ValueList the same way. Out of range or missing entries return 0. */
+	float GetFloatValueFromValueList(const UCurviestCurveValueList &ValueList, int Index, float InTime) const;
+
+	/** Evaluate every tag in Tags in container order with one lookup snapshot. Missing tags write 0. */
+	void GetFloatValuesFromTaggedCurves(const FGameplayTagContainer &Tags, float InTime, TArrayView<float> ValuesOut, bool bAllowParamLookup = true) const;
+
+	/**
+	 * Tagged lookup by gameplay tag net index, as replicated tags arrive. One array read when bDenseTagIndex is set.
+	 * Other threads only find anything once the game thread has built the asset's net index tables, which needs
+	 * bDenseTagIndex, since resolving the tag instead would ask the tag manager.
+	 */
+	bool GetFloatValueFromTagNetIndex(FGameplayTagNetIndex NetIndex, float InTime, float &ValueOut, bool bAllowParamLookup = true) const;
+
+	/** Evaluate every net index in NetIndices with one lookup snapshot. Missing tags write 0. */
+	void GetFloatValuesFromTagNetIndices(TArrayView<const FGameplayTagNetIndex> NetIndices, float InTime, TArrayView<float> ValuesOut, bool bAllowParamLookup = true) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves", meta = (BlueprintThreadSafe))
+	bool GetFloatValueFromTaggedParam(FGameplayTag IdentifierTag, float &ValueOut) const;
+
+	/** Every tag a tagged lookup finds, including inherited ones, sorted by name */
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves", meta = (BlueprintThreadSafe))
+	TArray<FGameplayTag> GetAllCurveIdentifierTags(bool bAllowParamLookup = true) const;
+	
+	/** Every param tag, including inherited ones, sorted by name */
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves", meta = (BlueprintThreadSafe))
+	TArray<FGameplayTag> GetAllParamIdentifierTags() const;
+
+	/** Same tags as GetAllCurveIdentifierTags without copying, valid while LookupsOut is held */
+	TArrayView<const FGameplayTag> GetCurveIdentifierTagsView(FCurviestLookupPin &LookupsOut, bool bAllowParamLookup = true) const;
+
+	/** Same tags as GetAllParamIdentifierTags without copying, valid while LookupsOut is held */
+	TArrayView<const FGameplayTag> GetParamIdentifierTagsView(FCurviestLookupPin &LookupsOut) const;
+
+	/** Number of values written by EvaluateAllCurves: every curve, then params not shadowed by a curve, then inherited parent values */
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves", meta = (BlueprintThreadSafe))
+	int GetNumEvaluationSlots() const;
+
+	/** Identifier tag for each slot written by EvaluateAllCurves (empty for untagged curves) */
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves", meta = (BlueprintThreadSafe))
+	TArray<FGameplayTag> GetEvaluationSlotTags() const;
+
+	/** Evaluate every slot at the specified time in one pass. Writes min(ValuesOut.Num(), GetNumEvaluationSlots()) values. */
+	void EvaluateAllCurves(float InTime, TArrayView<float> ValuesOut) const;
+
+	/** Resolve a tagged lookup once so repeated evaluation skips hashing */
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves", meta = (BlueprintThreadSafe))
+	FCurviestCurveHandle ResolveTaggedHandle(FGameplayTag IdentifierTag, bool bAllowParamLookup = true) const;
+
+	/** Resolve a named lookup once so repeated evaluation skips hashing */
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves", meta = (BlueprintThreadSafe))
+	FCurviestCurveHandle ResolveNamedHandle(FName Name) const;
+
+	/** True if Handle was resolved against this asset and nothing has changed since */
+	bool IsHandleCurrent(const FCurviestCurveHandle &Handle) const
+	{
+		return Handle.Asset == this && Handle.Generation == LayoutEpoch.load(std::memory_order_acquire);
+	}
+
+	/** Resolve Handle again if it is stale. Returns false if it no longer finds anything. */
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves", meta = (BlueprintThreadSafe))
+	bool RefreshHandle(UPARAM(ref) FCurviestCurveHandle &Handle) const;
+
+	/** Find the slots matching Query.Query and store them in Query. Returns how many matched. Writes Query, so no other thread may use it meanwhile. */
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves", meta = (BlueprintThreadSafe))
+	int CompileQuery(UPARAM(ref) FCurviestCurveQuery &Query) const;
+
+	/** True if Query was compiled against this asset and nothing has changed since */
+	bool IsQueryCurrent(const FCurviestCurveQuery &Query) const
+	{
+		return Query.Asset == this && Query.Generation == LayoutEpoch.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * Evaluate every slot Query matches, in slot order. Writes min(match count, ValuesOut.Num()) values and returns the
+	 * match count. A stale Query is compiled again in place on the game thread, so keep it somewhere that persists
+	 * between calls. Other threads only read Query and compile a stale one into a temporary copy on every call, so
+	 * several workers can share one query, as long as the game thread isn't evaluating it at the same time.
+	 */
+	int EvaluateQuery(FCurviestCurveQuery &Query, float InTime, TArrayView<float> ValuesOut) const;
+
+	/** Combine the values of every slot Query matches. An empty match gives 1 for Product and 0 otherwise. */
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves", meta = (BlueprintThreadSafe))
+	float EvaluateQueryAggregate(UPARAM(ref) FCurviestCurveQuery &Query, float InTime, ECurviestQueryAggregate Aggregate = ECurviestQueryAggregate::Sum) const;
+
+	/** Evaluate every slot Query matches, reusing the allocation of ValuesOut */
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves", meta = (BlueprintThreadSafe, DisplayName = "Evaluate Query"))
+	void EvaluateQueryToArray(UPARAM(ref) FCurviestCurveQuery &Query, float InTime, TArray<float> &ValuesOut) const;
+
+	/** Build the slot table of Blend over the union of its assets' tags. Returns the number of blended slots. */
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves")
+	static int CompileBlend(UPARAM(ref) FCurviestCurveBlend &Blend);
+
+	/** True if Blend was compiled against its current assets and nothing has changed since */
+	static bool IsBlendCurrent(const FCurviestCurveBlend &Blend);
+
+	/**
+	 * Evaluate every asset of Blend and write the weighted average of each tag in Blend.SlotTags order. Assets
+	 * without a tag don't count towards its weight, and missing weights are 0. Writes min(slot count, ValuesOut.Num())
+	 * values and returns the slot count. A stale Blend is compiled again in place, so keep it somewhere that persists.
+	 */
+	static int EvaluateBlend(FCurviestCurveBlend &Blend, TArrayView<const float> Weights, float InTime, TArrayView<float> ValuesOut);
+
+	/** Evaluate a blend, reusing the allocation of ValuesOut. Not thread safe, since Blend holds its own scratch space. */
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves", meta = (DisplayName = "Evaluate Blend"))
+	static void EvaluateBlendToArray(UPARAM(ref) FCurviestCurveBlend &Blend, const TArray<float> &Weights, float InTime, TArray<float> &ValuesOut);
+
+	/** Evaluate a resolved handle, falling back to a hashed lookup if it is stale. Returns 0 if nothing is found. */
+	float Eval(const FCurviestCurveHandle &Handle, float InTime) const;
+
+	/** Evaluate many resolved handles. Writes min(Handles.Num(), ValuesOut.Num()) values. */
+	void Eval(TArrayView<const FCurviestCurveHandle> Handles, float InTime, TArrayView<float> ValuesOut) const;
+
+	/** Evaluate a resolved handle, using Cursor to skip the key search when time moves forward */
+	float Eval(const FCurviestCurveHandle &Handle, float InTime, FCurviestEvalCursor &Cursor) const;
+
+	/** Evaluate many resolved handles with one cursor per handle. Writes min of the three counts. */
+	void Eval(TArrayView<const FCurviestCurveHandle> Handles, float InTime, TArrayView<FCurviestEvalCursor> Cursors, TArrayView<float> ValuesOut) const;
+
+	/** Evaluate one tagged curve or param at many times, writing min(Times.Num(), ValuesOut.Num()) values. Returns false and writes nothing if the tag isn't found. */
+	bool EvalMany(FGameplayTag IdentifierTag, TArrayView<const float> Times, TArrayView<float> ValuesOut, bool bAllowParamLookup = true) const;
+
+	/** Evaluate a resolved handle at many times, writing min(Times.Num(), ValuesOut.Num()) values. Writes 0 if nothing is found. */
+	void EvalMany(const FCurviestCurveHandle &Handle, TArrayView<const float> Times, TArrayView<float> ValuesOut) const;
+
+	/** Evaluate a named curve, using Cursor to skip the key search when time moves forward */
+	bool GetFloatValueFromNamedCurve(FName Name, float InTime, float &ValueOut, FCurviestEvalCursor &Cursor) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves", meta = (BlueprintThreadSafe, DisplayName = "Get Float Value From Handle"))
+	float GetFloatValueFromHandle(const FCurviestCurveHandle &Handle, float InTime) const;
+
+	/** Evaluate every slot at the specified time, reusing the allocation of ValuesOut */
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves", meta = (BlueprintThreadSafe, DisplayName = "Evaluate All Curves"))
+	void EvaluateAllCurvesToArray(float InTime, TArray<float> &ValuesOut) const;
+
+	// Begin FCurveOwnerInterface
+	virtual TArray<FRichCurveEditInfoConst> GetCurves() const override;
+	/**
+	 * Editable curves, for the game thread only. Pooled keys are copied back into this asset first so edits
+	 * can't reach other assets. Compressed curves keep no keys, so they are handed out empty.
+	 */
+	virtual TArray<FRichCurveEditInfo> GetCurves() override;
+
+	/** @return Color for this curve */
+	virtual FLinearColor GetCurveColor(FRichCurveEditInfo CurveInfo) const override;
+
+	/** Determine if Curve has the same keys in the same order. Differing content hashes reject without comparing keys while both are current. */
+	bool operator == (const UCurveCurviest& Curve) const;
+
+	/** Hash of every curve's keys in order, updated with the segment caches. Keys edited from code need RebuildSegmentCurves. */
+	uint64 GetContentHash() const { return ContentHash; }
+
+	virtual bool IsValidCurve(FRichCurveEditInfo CurveInfo) override;
+
+	virtual void PostLoad() override;
+	virtual void Serialize(FArchive &Ar) override;
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
+#if WITH_EDITOR
+	void MakeCurveNameUnique(int CurveIdx);
+
+	virtual void PostEditUndo() override;
+
+	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& e) override;
+
+	virtual void PreEditChange(class FEditPropertyChain& e) override;
+	virtual void PostEditChangeChainProperty(struct FPropertyChangedChainEvent& e) override;
+	virtual void OnCurveChanged(const TArray<FRichCurveEditInfo>& ChangedCurveEditInfos) override;
+#endif
+
+#if WITH_EDITORONLY_DATA
+	FOnCurveMapChanged OnCurveMapChanged;
+#endif
+
+	UPROPERTY(EditAnywhere, Category = "Curviest")
+	UCurveCurviest *Parent = nullptr;
+
+	UPROPERTY(EditAnywhere, Category = "Curviest", meta = (NoResetToDefault))
+	TArray<FCurviestCurveData> CurveData;
+
+	UPROPERTY(EditAnywhere, Category = "Curviest", meta = (NoResetToDefault))
+	TArray<FCurviestCurveFloatParam> Params;
+
+	// When a tag isn't found, use the curve or param of its nearest ancestor tag instead, so Damage.Fire.Small can
+	// share Damage.Fire. Fallbacks are resolved for every registered tag when the lookups are built.
+	UPROPERTY(EditAnywhere, Category = "Curviest|Lookups")
+	bool bFallBackToParentTags = false;
+
+	// Also index tagged curves and params by gameplay tag net index, so GetFloatValueFromTagNetIndex is an array read
+	UPROPERTY(EditAnywhere, Category = "Curviest|Lookups")
+	bool bDenseTagIndex = false;
+
+	// Resample every curve into a fixed rate table so evaluation is an index and a lerp instead of a key search
+	UPROPERTY(EditAnywhere, Category = "Curviest|Baking")
+	bool bBakeCurves = false;
+
+	// Starting samples per second, doubled per curve until BakeErrorTolerance is met
+	UPROPERTY(EditAnywhere, Category = "Curviest|Baking", meta = (EditCondition = "bBakeCurves", ClampMin = "1.0"))
+	float BakeSampleRate = 30.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Curviest|Baking", meta = (EditCondition = "bBakeCurves", ClampMin = "0.0"))
+	float BakeErrorTolerance = 0.001f;
+
+	UPROPERTY(EditAnywhere, Category = "Curviest|Baking", meta = (EditCondition = "bBakeCurves", ClampMin = "2"))
+	int BakeMaxSamplesPerCurve = 4096;
+
+#if WITH_EDITORONLY_DATA
+	// Largest difference between the baked tables and the source curves
+	UPROPERTY(VisibleAnywhere, Transient, Category = "Curviest|Baking")
+	float BakedMaxError = 0.0f;
+
+	UPROPERTY(VisibleAnywhere, Transient, Category = "Curviest|Baking")
+	int BakedMemoryBytes = 0;
+#endif
+
+	void RebuildBakedCurves();
+
+	// Convert every curve to key times plus one cubic per segment, so evaluation is a search and a Horner step
+	// instead of FRichCurve's per key interpolation. Curves with weighted tangents are left as they are.
+	UPROPERTY(EditAnywhere, Category = "Curviest|Segments")
+	bool bCacheSegmentCoefficients = false;
+
+#if WITH_EDITORONLY_DATA
+	UPROPERTY(VisibleAnywhere, Transient, Category = "Curviest|Segments")
+	int SegmentMemoryBytes = 0;
+
+	// Curves using weighted tangents, which can't be cached as plain cubics
+	UPROPERTY(VisibleAnywhere, Transient, Category = "Curviest|Segments")
+	int UncachedSegmentCurves = 0;
+#endif
+
+	/** Rebuild the content hash, cached coefficients and key search index for one curve, or for every curve if CurveIdx is INDEX_NONE */
+	void RebuildSegmentCurves(int CurveIdx = INDEX_NONE);
+
+	/** Combine the per curve content hashes into the asset's */
+	void UpdateContentHash();
+
+	// Find curves with identical key times and evaluate them against one shared time axis in EvaluateAllCurves,
+	// one key search per axis instead of per curve. Ignored while baking, which already skips the search.
+	UPROPERTY(EditAnywhere, Category = "Curviest|Segments")
+	bool bShareKeyTimes = false;
+
+#if WITH_EDITORONLY_DATA
+	UPROPERTY(VisibleAnywhere, Transient, Category = "Curviest|Segments")
+	int SharedTimeAxisCount = 0;
+
+	UPROPERTY(VisibleAnywhere, Transient, Category = "Curviest|Segments")
+	int SharedTimeCurveCount = 0;
+#endif
+
+	/** Group curves by identical key times. The curves themselves are unchanged, so editing through GetCurves() is unaffected. */
+	void RebuildSharedTimeAxes();
+
+	// Quantize keys to 16 bits per time and value when cooking, and drop tangents that linear and constant keys don't use
+	UPROPERTY(EditAnywhere, Category = "Curviest|Compression")
+	bool bCompressKeysOnCook = false;
+
+	// Cook tagged curves without their names, leaving tags as the only way to find them in cooked builds. Tagged
+	// Blueprint nodes compiled against this asset keep working since their resolved slots don't depend on these names.
+	// Name based nodes aren't resolved against it, in this asset or any child.
+	UPROPERTY(EditAnywhere, Category = "Curviest|Compression")
+	bool bStripTaggedCurveNamesOnCook = false;
+
+	// In cooked builds, keep one copy of the keys of curves identical to a curve in another loaded asset. Curves are
+	// pooled as they load, by a content hash computed then rather than stored at cook, so editor and uncooked builds
+	// never pool. Off by default, since a pooled curve's own Curve is left empty and code reading it rather than
+	// GetCurve() sees no keys, and the non const GetCurves() copies pooled keys back into the asset so they can be
+	// edited. See Curviest.SharedCurveStats for what this saves.
+	UPROPERTY(EditAnywhere, Category = "Curviest|Compression")
+	bool bShareIdenticalCurves = false;
+
+	/** Move the keys of each uncompressed curve into FCurviestCurvePool. Only done in cooked builds, where nothing edits them. */
+	void ShareIdenticalCurves();
+
+#if WITH_EDITORONLY_DATA
+	// Key memory before and after cook compression, and the largest difference it introduces
+	UPROPERTY(VisibleAnywhere, Transient, Category = "Curviest|Compression")
+	int UncompressedKeyBytes = 0;
+
+	UPROPERTY(VisibleAnywhere, Transient, Category = "Curviest|Compression")
+	int CompressedKeyBytes = 0;
+
+	UPROPERTY(VisibleAnywhere, Transient, Category = "Curviest|Compression")
+	float CompressedMaxError = 0.0f;
+
+	// Curves with weighted tangents, which are cooked uncompressed
+	UPROPERTY(VisibleAnywhere, Transient, Category = "Curviest|Compression")
+	int UncompressibleCurves = 0;
+#endif
+
+#if WITH_EDITOR
+	void UpdateCompressionStats();
+#endif
+
+	/**
+	 * Current lookup tables, built on first use. Safe to call from any thread. The tables stay valid for as long as
+	 * the returned pin is held, including by a task or ParallelFor that outlives the frame, even if the asset changes.
+	 */
+	FCurviestLookupPin GetLookups() const;
+
+	/** Layout generation handles and snapshots are stamped with, bumped by InvalidateLookups */
+	static std::atomic<uint32> LayoutEpoch;
+
+	/** Mark every lookup snapshot for rebuild on next use. Children flatten their parents, so one edit can affect many assets. */
+	static void InvalidateLookups();
+
+	/** This asset followed by its parents, stopping before the first asset that repeats */
+	void GetParentChain(TArray<const UCurveCurviest*> &ChainOut, bool &bHasCycleOut) const;
+
+	/** Replace the lookup tables immediately rather than on next use */
+	void RebuildLookupMaps();
+
+protected:
+	FCurviestLookupSnapshot *BuildLookupSnapshot() const;
+
+	/** Build a snapshot for Epoch and try to replace Snapshot with it */
+	FCurviestLookupPin PublishLookups(const FCurviestLookupSnapshot *Snapshot, uint32 Epoch) const;
+	void SerializeCompressedCurves(FArchive &Ar);
+
+	/** Keys of every curve as packed blocks. When saving, SourceKeys holds the keys swapped out of the tagged properties. */
+	void SerializePackedKeys(FArchive &Ar, bool bPackKeys, TArray<TArray<FRichCurveKey>> &SourceKeys);
+
+	int OldCurveCount;
+
+	mutable std::atomic<const FCurviestLookupSnapshot*> LookupSnapshot { nullptr };
+
+	TArray<FCurviestSharedTimeAxis> SharedTimeAxes;
+
+	uint64 ContentHash = 0;
+
+	// Set once GetCurves() hands out editable keys, which may change without a rehash, until the edit is reported
+	// through OnCurveChanged or PostEditChangeProperty and the curves are rehashed
+	bool bContentHashMayBeStale = false;
+
+};
+
+inline float FCurviestEvaluationSlot::Eval(float InTime) const
+{
+	return bIsParam ? Owner->Params[Index].Value : Owner->CurveData[Index].Eval(InTime);
+}
+
+inline float FCurviestEvaluationSlot::Eval(float InTime, FCurviestEvalCursor &Cursor) const
+{
+	return bIsParam ? Owner->Params[Index].Value : Owner->CurveData[Index].Eval(InTime, Cursor);
+}
+
+inline void FCurviestEvaluationSlot::EvalMany(TArrayView<const float> Times, TArrayView<float> ValuesOut) const
+{
+	if (bIsParam)
+	{
+		const int NumValues = FMath::Min(Times.Num(), ValuesOut.Num());
+		for (int i = 0; i < NumValues; i++)
+			ValuesOut[i] = Owner->Params[Index].Value;
+	}
+	else
+	{
+		Owner->CurveData[Index].EvalMany(Times, ValuesOut);
+	}
+}
\ No newline at end of file
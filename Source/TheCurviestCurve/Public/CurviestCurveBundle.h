@@ -0,0 +1,417 @@
+// Copyright 2019 Skyler Clark. All Rights Reserved.
+
+#pragma once
+
+// Standalone reader for Curviest bundles written by FCurviestCurveBundleExporter. Plain C++ with no engine
+// dependency, so build tools and offline simulators can read a bundle and sample curves without booting the
+// engine. Extras/CurviestBundleReader/CurviestCurveBundleFile.h maps a bundle file for them. Evaluation follows the same steps as UCurveCurviest::GetFloatValueFromTaggedCurve; build with
+// floating point contraction off (-ffp-contract=off, /fp:precise) to get the same bits.
+//
+// Layout, little endian with every block 4 byte aligned and every offset from the start of the bundle:
+//   FHeader
+//   FAsset[NumAssets]
+//   per asset, in order:
+//     its name string
+//     FEntry array sorted by tag of the resolved curves, then the tag strings and FCurve blocks its entries
+//     reference that weren't written earlier, in entry order
+//     the same for the resolved curves and params together
+// Each FCurve block is followed by its key, baked sample and segment coefficient arrays. Strings are not null
+// terminated, and identical strings and curves shared through parent chains are written once.
+
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <cmath>
+
+namespace CurviestBundle
+{
+	static constexpr uint32_t Magic = 0x46424343; // "CCBF"
+	static constexpr uint32_t Version = 1;
+
+	// FEntry::CurveOffset of a curve the exporter couldn't write in a form that evaluates the same. Lookups
+	// still find it so they don't fall back to a parent tag, but Eval on the asset fails.
+	static constexpr uint32_t UnsupportedCurve = 0xFFFFFFFF;
+
+	// Same values as the engine's ERichCurveExtrapolation and ERichCurveInterpMode
+	enum EExtrapolation : uint32_t
+	{
+		Extrap_Cycle = 0,
+		Extrap_CycleWithOffset,
+		Extrap_Oscillate,
+		Extrap_Linear,
+		Extrap_Constant,
+		Extrap_None,
+	};
+
+	enum EInterpMode : uint32_t
+	{
+		Interp_Linear = 0,
+		Interp_Constant,
+		Interp_Cubic,
+		Interp_None,
+	};
+
+	enum EAssetFlags : uint32_t
+	{
+		// Tagged misses fall back to the nearest ancestor tag that resolves
+		AF_FallBackToParentTags = 1 << 0,
+	};
+
+	struct FHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t TotalSize;
+		uint32_t NumAssets;
+		uint32_t AssetsOffset;
+	};
+
+	struct FAsset
+	{
+		// Object path of the exported asset
+		uint32_t NameOffset;
+		uint32_t NameLength;
+		uint32_t Flags;
+
+		// Tagged curves, for lookups that don't allow params
+		uint32_t NumCurveEntries;
+		uint32_t CurveEntriesOffset;
+
+		// Tagged curves and params together, as resolved over the parent chain
+		uint32_t NumValueEntries;
+		uint32_t ValueEntriesOffset;
+	};
+
+	struct FEntry
+	{
+		uint32_t TagOffset;
+		uint32_t TagLength;
+
+		// FCurve to evaluate, 0 for a param or UnsupportedCurve
+		uint32_t CurveOffset;
+		float ParamValue;
+	};
+
+	struct FCurve
+	{
+		float DefaultValue;
+		uint32_t PreInfinityExtrap;
+		uint32_t PostInfinityExtrap;
+
+		// One float or uint32 per key in each array
+		uint32_t NumKeys;
+		uint32_t KeyTimesOffset;
+		uint32_t KeyValuesOffset;
+		uint32_t ArriveTangentsOffset;
+		uint32_t LeaveTangentsOffset;
+		uint32_t InterpModesOffset;
+
+		// Uniform samples over the key range, used inside it when NumBakedSamples is at least 2
+		float BakedStartTime;
+		float BakedEndTime;
+		float BakedSamplesPerSecond;
+		uint32_t NumBakedSamples;
+		uint32_t BakedSamplesOffset;
+
+		// Four coefficients per key segment, highest power first in seconds from the segment's key. 0 if not cached.
+		uint32_t SegmentCoefficientsOffset;
+	};
+
+	/** Lexicographic byte order with shorter strings first, the order entries are sorted in */
+	inline int CompareTags(const char *A, uint32_t LengthA, const char *B, uint32_t LengthB)
+	{
+		const int Result = std::memcmp(A, B, LengthA < LengthB ? LengthA : LengthB);
+		return Result != 0 ? Result : (LengthA < LengthB ? -1 : LengthA > LengthB ? 1 : 0);
+	}
+
+	/** A bundle in memory, read in place. Only the header is checked up front; nothing is parsed or copied. */
+	class FBundleView
+	{
+	public:
+		bool Open(const void *InData, size_t InSize)
+		{
+			Data = static_cast<const uint8_t*>(InData);
+			Size = InSize;
+			Header = At<FHeader>(0);
+			if (!Header || Header->Magic != Magic || Header->Version != Version || Header->TotalSize > Size || !At<FAsset>(Header->AssetsOffset, Header->NumAssets))
+			{
+				Header = nullptr;
+				return false;
+			}
+			return true;
+		}
+
+		bool IsOpen() const { return Header != nullptr; }
+
+		uint32_t GetNumAssets() const { return Header ? Header->NumAssets : 0; }
+
+		const FAsset *GetAsset(uint32_t Index) const
+		{
+			return Index < GetNumAssets() ? At<FAsset>(Header->AssetsOffset) + Index : nullptr;
+		}
+
+		/** Asset exported from the object path Name, such as "/Game/Curves/Stance.Stance" */
+		const FAsset *FindAsset(const char *Name) const
+		{
+			const uint32_t Length = (uint32_t)std::strlen(Name);
+			for (uint32_t i = 0; i < GetNumAssets(); i++)
+			{
+				const FAsset *Asset = GetAsset(i);
+				const char *AssetName = At<char>(Asset->NameOffset, Asset->NameLength);
+				if (AssetName && CompareTags(AssetName, Asset->NameLength, Name, Length) == 0)
+					return Asset;
+			}
+			return nullptr;
+		}
+
+		/**
+		 * Entry for Tag, such as "Stance.Crouch.Speed", falling back to ancestor tags if the asset was exported with that
+		 * enabled. Ancestors are found by cutting Tag at each '.', so unlike the engine, whose fallback only covers
+		 * registered descendants of an exported tag, this also resolves tags the engine doesn't have registered.
+		 */
+		const FEntry *FindTagged(const FAsset &Asset, const char *Tag, bool bAllowParamLookup = true) const
+		{
+			uint32_t Length = (uint32_t)std::strlen(Tag);
+			const FEntry *Entry = FindExact(Asset, Tag, Length, bAllowParamLookup);
+			if (Entry || !(Asset.Flags & AF_FallBackToParentTags))
+				return Entry;
+
+			while (!Entry && Length > 0)
+			{
+				while (Length > 0 && Tag[Length - 1] != '.')
+					Length--;
+				if (Length > 0)
+					Entry = FindExact(Asset, Tag, --Length, bAllowParamLookup);
+			}
+			return Entry;
+		}
+
+		float Eval(const FEntry &Entry, float InTime) const
+		{
+			const FCurve *Curve = Entry.CurveOffset != 0 && Entry.CurveOffset != UnsupportedCurve ? At<FCurve>(Entry.CurveOffset) : nullptr;
+			return Curve ? EvalCurve(*Curve, InTime) : Entry.ParamValue;
+		}
+
+		/** Same as UCurveCurviest::GetFloatValueFromTaggedCurve on the exported asset */
+		bool Eval(const FAsset &Asset, const char *Tag, float InTime, float &ValueOut, bool bAllowParamLookup = true) const
+		{
+			const FEntry *Entry = FindTagged(Asset, Tag, bAllowParamLookup);
+			if (!Entry || Entry->CurveOffset == UnsupportedCurve)
+				return false;
+			ValueOut = Eval(*Entry, InTime);
+			return true;
+		}
+
+		/** Pointer to Count values at Offset, or null if they aren't inside the bundle or aren't aligned */
+		template<typename T>
+		const T *At(uint32_t Offset, uint32_t Count = 1) const
+		{
+			if (Offset % alignof(T) != 0 || Offset > Size || (Size - Offset) / sizeof(T) < Count)
+				return nullptr;
+			return reinterpret_cast<const T*>(Data + Offset);
+		}
+
+	private:
+		const FEntry *FindExact(const FAsset &Asset, const char *Tag, uint32_t Length, bool bAllowParamLookup) const
+		{
+			const uint32_t NumEntries = bAllowParamLookup ? Asset.NumValueEntries : Asset.NumCurveEntries;
+			const FEntry *Entries = At<FEntry>(bAllowParamLookup ? Asset.ValueEntriesOffset : Asset.CurveEntriesOffset, NumEntries);
+			if (!Entries)
+				return nullptr;
+
+			uint32_t First = 0;
+			uint32_t Count = NumEntries;
+			while (Count > 0)
+			{
+				const uint32_t Step = Count / 2;
+				const FEntry &Middle = Entries[First + Step];
+				const char *MiddleTag = At<char>(Middle.TagOffset, Middle.TagLength);
+				const int Order = MiddleTag ? CompareTags(MiddleTag, Middle.TagLength, Tag, Length) : 1;
+				if (Order == 0)
+					return &Middle;
+				if (Order < 0)
+				{
+					First += Step + 1;
+					Count -= Step + 1;
+				}
+				else
+				{
+					Count = Step;
+				}
+			}
+			return nullptr;
+		}
+
+		static float Lerp(float A, float B, float Alpha)
+		{
+			return A + Alpha * (B - A);
+		}
+
+		float EvalCurve(const FCurve &Curve, float InTime) const
+		{
+			const uint32_t NumKeys = Curve.NumKeys;
+			const float *Times = At<float>(Curve.KeyTimesOffset, NumKeys);
+			const float *Values = At<float>(Curve.KeyValuesOffset, NumKeys);
+			const float *Arrive = At<float>(Curve.ArriveTangentsOffset, NumKeys);
+			const float *Leave = At<float>(Curve.LeaveTangentsOffset, NumKeys);
+			const uint32_t *Modes = At<uint32_t>(Curve.InterpModesOffset, NumKeys);
+			if (!Times || !Values || !Arrive || !Leave || !Modes)
+				return 0.0f;
+
+			// Baked table inside the key range, as FCurviestBakedCurve::EvalInRange
+			const float *Samples = Curve.NumBakedSamples >= 2 ? At<float>(Curve.BakedSamplesOffset, Curve.NumBakedSamples) : nullptr;
+			if (Samples && InTime >= Curve.BakedStartTime && InTime <= Curve.BakedEndTime)
+			{
+				const float Position = (InTime - Curve.BakedStartTime) * Curve.BakedSamplesPerSecond;
+				const int MaxIdx = (int)Curve.NumBakedSamples - 2;
+				const int Idx = (int)Position < MaxIdx ? (int)Position : MaxIdx;
+				return Lerp(Samples[Idx], Samples[Idx + 1], Position - (float)Idx);
+			}
+
+			// Cached segment coefficients from the first key up to the last, as FCurviestSegmentCurve::EvalInRange
+			// The count is checked first so it can't wrap and pass the bounds check with a small value
+			const float *Coefficients = Curve.SegmentCoefficientsOffset != 0 && NumKeys >= 2 && NumKeys <= UINT32_MAX / 4
+				? At<float>(Curve.SegmentCoefficientsOffset, (NumKeys - 1) * 4) : nullptr;
+			if (Coefficients && InTime >= Times[0] && InTime < Times[NumKeys - 1])
+			{
+				const uint32_t Segment = FindSegment(Times, NumKeys, InTime);
+				const float *Coefficient = &Coefficients[Segment * 4];
+				const float Offset = InTime - Times[Segment];
+				return ((Coefficient[0] * Offset + Coefficient[1]) * Offset + Coefficient[2]) * Offset + Coefficient[3];
+			}
+
+			// Everything else as FRichCurve::Eval
+			if (NumKeys == 0)
+				return Curve.DefaultValue == 3.402823466e+38f ? 0.0f : Curve.DefaultValue;
+
+			float CycleValueOffset = 0.0f;
+			RemapTime(Curve, Times, Values, InTime, CycleValueOffset);
+
+			float Value;
+			if (NumKeys < 2 || InTime <= Times[0])
+			{
+				Value = Values[0];
+				if (Curve.PreInfinityExtrap == Extrap_Linear && NumKeys > 1)
+				{
+					const float DT = Times[1] - Times[0];
+					if (std::fabs(DT) > 1.e-8f)
+						Value = (Values[1] - Values[0]) / DT * (InTime - Times[0]) + Values[0];
+				}
+			}
+			else if (InTime < Times[NumKeys - 1])
+			{
+				const uint32_t Segment = FindSegment(Times, NumKeys, InTime);
+				Value = EvalSegment(Times, Values, Arrive, Leave, Modes, Segment, InTime);
+			}
+			else
+			{
+				Value = Values[NumKeys - 1];
+				if (Curve.PostInfinityExtrap == Extrap_Linear)
+				{
+					const float DT = Times[NumKeys - 2] - Times[NumKeys - 1];
+					if (std::fabs(DT) > 1.e-8f)
+						Value = (Values[NumKeys - 2] - Values[NumKeys - 1]) / DT * (InTime - Times[NumKeys - 1]) + Values[NumKeys - 1];
+				}
+			}
+
+			return Value + CycleValueOffset;
+		}
+
+		// Index of the key starting the segment containing InTime, the same upper bound FRichCurve::Eval uses
+		static uint32_t FindSegment(const float *Times, uint32_t NumKeys, float InTime)
+		{
+			uint32_t First = 1;
+			uint32_t Count = NumKeys - 2;
+			while (Count > 0)
+			{
+				const uint32_t Step = Count / 2;
+				const uint32_t Middle = First + Step;
+				if (InTime >= Times[Middle])
+				{
+					First = Middle + 1;
+					Count -= Step + 1;
+				}
+				else
+				{
+					Count = Step;
+				}
+			}
+			return First - 1;
+		}
+
+		// The exporter leaves out curves with weighted tangents wherever this would be reached for them
+		static float EvalSegment(const float *Times, const float *Values, const float *Arrive, const float *Leave, const uint32_t *Modes, uint32_t Segment, float InTime)
+		{
+			const float Diff = Times[Segment + 1] - Times[Segment];
+			if (Diff <= 0.0f || Modes[Segment] == Interp_Constant)
+				return Values[Segment];
+
+			const float Alpha = (InTime - Times[Segment]) / Diff;
+			const float P0 = Values[Segment];
+			const float P3 = Values[Segment + 1];
+			if (Modes[Segment] == Interp_Linear)
+				return Lerp(P0, P3, Alpha);
+
+			const float OneThird = 1.0f / 3.0f;
+			const float P1 = P0 + (Leave[Segment] * Diff * OneThird);
+			const float P2 = P3 - (Arrive[Segment + 1] * Diff * OneThird);
+			const float P01 = Lerp(P0, P1, Alpha);
+			const float P12 = Lerp(P1, P2, Alpha);
+			const float P23 = Lerp(P2, P3, Alpha);
+			const float P012 = Lerp(P01, P12, Alpha);
+			const float P123 = Lerp(P12, P23, Alpha);
+			return Lerp(P012, P123, Alpha);
+		}
+
+		// Cycle and oscillate extrapolation, as FRichCurve::RemapTimeValue
+		static void RemapTime(const FCurve &Curve, const float *Times, const float *Values, float &InTime, float &CycleValueOffset)
+		{
+			const uint32_t NumKeys = Curve.NumKeys;
+			if (NumKeys < 2)
+				return;
+
+			const float MinTime = Times[0];
+			const float MaxTime = Times[NumKeys - 1];
+			const bool bBefore = InTime <= MinTime;
+			if (!bBefore && InTime < MaxTime)
+				return;
+
+			const uint32_t Extrap = bBefore ? Curve.PreInfinityExtrap : Curve.PostInfinityExtrap;
+			const float Duration = MaxTime - MinTime;
+			if (Extrap == Extrap_Linear || Extrap == Extrap_Constant || Duration <= 0.0f)
+				return;
+
+			const float InitTime = InTime;
+			int CycleCount = 0;
+			if (InTime > MaxTime)
+			{
+				CycleCount = (int)std::floor((MaxTime - InTime) / Duration);
+				InTime = InTime + Duration * CycleCount;
+			}
+			else if (InTime < MinTime)
+			{
+				CycleCount = (int)std::floor((InTime - MinTime) / Duration);
+				InTime = InTime - Duration * CycleCount;
+			}
+			if (InTime == MaxTime && InitTime < MinTime)
+				InTime = MinTime;
+			if (InTime == MinTime && InitTime > MaxTime)
+				InTime = MaxTime;
+			CycleCount = CycleCount < 0 ? -CycleCount : CycleCount;
+
+			if (Extrap == Extrap_CycleWithOffset)
+			{
+				const float DV = bBefore ? Values[0] - Values[NumKeys - 1] : Values[NumKeys - 1] - Values[0];
+				CycleValueOffset = DV * CycleCount;
+			}
+			else if (Extrap == Extrap_Oscillate && CycleCount % 2 == 1)
+			{
+				InTime = MinTime + (MaxTime - InTime);
+			}
+		}
+
+		const uint8_t *Data = nullptr;
+		size_t Size = 0;
+		const FHeader *Header = nullptr;
+	};
+}
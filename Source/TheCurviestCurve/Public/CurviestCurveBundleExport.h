@@ -0,0 +1,30 @@
+// Copyright 2019 Skyler Clark. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UCurveCurviest;
+struct FCurviestCurveData;
+
+/**
+ * Writes UCurveCurviest assets into the flat bundle format read by CurviestCurveBundle.h, with each asset's
+ * parent chain resolved, so tools outside the engine can sample the curves and get the same values.
+ */
+class THECURVIESTCURVE_API FCurviestCurveBundleExporter
+{
+public:
+	void AddAsset(const UCurveCurviest *Asset);
+
+	/** Write every asset added so far. @return the number of curves written as unsupported */
+	int Write(TArray<uint8> &BytesOut) const;
+
+	/**
+	 * Whether the standalone reader evaluates Data the same as the asset does. Compressed keys, and weighted
+	 * tangents anywhere the engine's solver would be reached for them, can't be reproduced.
+	 */
+	static bool CanExportExactly(const FCurviestCurveData &Data);
+
+private:
+	TArray<const UCurveCurviest*> Assets;
+};
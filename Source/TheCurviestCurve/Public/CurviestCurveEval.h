@@ -0,0 +1,406 @@
+// Copyright 2019 Skyler Clark. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Curves/RichCurve.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+struct FCurviestEvalCursor;
+
+/** Uniformly resampled copy of a curve, evaluated with one table index and a lerp */
+struct THECURVIESTCURVE_API FCurviestBakedCurve
+{
+	float StartTime = 0.0f;
+	float EndTime = 0.0f;
+	float SamplesPerSecond = 0.0f;
+	TArray<float> Samples;
+
+	bool IsValid() const { return Samples.Num() >= 2; }
+
+	void Reset()
+	{
+		StartTime = EndTime = SamplesPerSecond = 0.0f;
+		Samples.Empty();
+	}
+
+	/**
+	 * Resample Source between Start and End, doubling the rate until the measured error is within
+	 * Tolerance or MaxSamples is reached. Empty ranges are left unbaked.
+	 *
+	 * @return The largest difference from Source found while checking the table
+	 */
+	float Build(TFunctionRef<float(float)> Source, float Start, float End, float InSamplesPerSecond, float Tolerance, int MaxSamples);
+
+	/** True if InTime is inside the baked range. Outside it the source curve handles extrapolation. */
+	FORCEINLINE bool Contains(float InTime) const
+	{
+		return InTime >= StartTime && InTime <= EndTime && IsValid();
+	}
+
+	FORCEINLINE float EvalInRange(float InTime) const
+	{
+		const float Position = (InTime - StartTime) * SamplesPerSecond;
+		const int Idx = FMath::Min((int)Position, Samples.Num() - 2);
+		return FMath::Lerp(Samples[Idx], Samples[Idx + 1], Position - (float)Idx);
+	}
+
+	SIZE_T GetAllocatedSize() const { return Samples.GetAllocatedSize(); }
+};
+
+/**
+ * Cooked form of an FRichCurve with key times and values quantized to 16 bits within the curve's own
+ * range. Tangents are only kept for cubic segments and decoded on the fly. Weighted tangents can't be
+ * represented, so curves using them stay uncompressed.
+ */
+struct THECURVIESTCURVE_API FCurviestCompressedCurve
+{
+	float TimeMin = 0.0f;
+	float TimeStep = 0.0f;
+	float ValueMin = 0.0f;
+	float ValueStep = 0.0f;
+	float DefaultValue = MAX_flt;
+	uint8 PreInfinityExtrap = RCCE_Constant;
+	uint8 PostInfinityExtrap = RCCE_Constant;
+
+	TArray<uint16> Times;
+	TArray<uint16> Values;
+	TArray<uint8> InterpModes;
+
+	// For each key starting a cubic segment, where its leave and the next key's arrive tangent live in Tangents
+	TArray<uint16> TangentIndex;
+	TArray<float> Tangents;
+
+	bool bIsCompressed = false;
+
+	bool IsValid() const { return bIsCompressed; }
+
+	void Reset() { *this = FCurviestCompressedCurve(); }
+
+	/** Compress Curve. Returns false and stays invalid if the curve uses anything that can't be represented. */
+	bool Build(const FRichCurve &Curve);
+
+	/** Largest difference from Curve, checked at each key and between keys */
+	float MeasureError(const FRichCurve &Curve) const;
+
+	float Eval(float InTime) const;
+
+	int GetNumKeys() const { return Times.Num(); }
+	float GetKeyTime(int KeyIdx) const { return TimeMin + Times[KeyIdx] * TimeStep; }
+	float GetKeyValue(int KeyIdx) const { return ValueMin + Values[KeyIdx] * ValueStep; }
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Times.GetAllocatedSize() + Values.GetAllocatedSize() + InterpModes.GetAllocatedSize() + TangentIndex.GetAllocatedSize() + Tangents.GetAllocatedSize();
+	}
+
+	bool operator==(const FCurviestCompressedCurve &Other) const
+	{
+		return TimeMin == Other.TimeMin && TimeStep == Other.TimeStep && ValueMin == Other.ValueMin && ValueStep == Other.ValueStep
+			&& DefaultValue == Other.DefaultValue && PreInfinityExtrap == Other.PreInfinityExtrap && PostInfinityExtrap == Other.PostInfinityExtrap
+			&& Times == Other.Times && Values == Other.Values && InterpModes == Other.InterpModes && TangentIndex == Other.TangentIndex
+			&& Tangents == Other.Tangents && bIsCompressed == Other.bIsCompressed;
+	}
+
+	friend FArchive &operator<<(FArchive &Ar, FCurviestCompressedCurve &Curve)
+	{
+		Ar << Curve.TimeMin << Curve.TimeStep << Curve.ValueMin << Curve.ValueStep << Curve.DefaultValue;
+		Ar << Curve.PreInfinityExtrap << Curve.PostInfinityExtrap;
+		Ar << Curve.Times << Curve.Values << Curve.InterpModes << Curve.TangentIndex << Curve.Tangents;
+		Ar << Curve.bIsCompressed;
+		return Ar;
+	}
+
+private:
+	float EvalSegment(int KeyIdx, float InTime) const;
+	void RemapTime(float &InTime, float &CycleValueOffset) const;
+};
+
+/**
+ * Key times plus one cubic per segment in seconds from the segment start, so evaluation is a key search and a
+ * Horner step with no interp mode branches. Constant and linear segments are stored as cubics with zero
+ * higher terms. Weighted tangents aren't polynomial in time, so curves using them are left unbuilt.
+ */
+struct THECURVIESTCURVE_API FCurviestSegmentCurve
+{
+	// Times[i] starts segment i, the last entry is the final key
+	TArray<float> Times;
+
+	// Four coefficients per segment, highest power first
+	TArray<float> Coefficients;
+
+	bool IsValid() const { return Times.Num() >= 2; }
+
+	/** True if built from a curve with NumKeys keys, so segment indices found in those keys are in range */
+	bool IsBuiltFor(int NumKeys) const { return IsValid() && Times.Num() == NumKeys; }
+
+	void Reset()
+	{
+		Times.Empty();
+		Coefficients.Empty();
+	}
+
+	/** @return False if Curve has fewer than two keys or uses weighted tangents */
+	bool Build(const FRichCurve &Curve);
+
+	/** True from the first key up to, but not including, the last key. Outside that the source curve handles extrapolation. */
+	FORCEINLINE bool Contains(float InTime) const
+	{
+		return IsValid() && InTime >= Times[0] && InTime < Times.Last();
+	}
+
+	float EvalInRange(float InTime) const;
+
+	/** Same as above, using Cursor to find the segment when time moves forward like FCurviestCurveEval::EvalWithCursor */
+	float EvalInRange(float InTime, FCurviestEvalCursor &Cursor) const;
+
+	/** Evaluate inside a segment already found, for example by an FCurviestKeySearchIndex built from the same keys */
+	FORCEINLINE float EvalSegment(int Segment, float InTime) const
+	{
+		const float *Coefficient = &Coefficients[Segment * 4];
+		const float Offset = InTime - Times[Segment];
+		return ((Coefficient[0] * Offset + Coefficient[1]) * Offset + Coefficient[2]) * Offset + Coefficient[3];
+	}
+
+	SIZE_T GetAllocatedSize() const { return Times.GetAllocatedSize() + Coefficients.GetAllocatedSize(); }
+};
+
+/**
+ * Key times of a large curve in Eytzinger order, the implicit binary tree laid out breadth first, so the first
+ * levels of every search share cache lines and the level four steps ahead can be prefetched. The search is branchless.
+ */
+struct THECURVIESTCURVE_API FCurviestKeySearchIndex
+{
+	// Curves with fewer keys are searched directly, see Curviest.Benchmark.KeySearch
+	static constexpr int MinKeys = 1024;
+
+	static bool ShouldBuild(int NumKeys) { return NumKeys >= MinKeys; }
+
+	// Times of keys 1 to Num - 2 by tree node, starting at node 1
+	TArray<float> Times;
+
+	// Segment whose end key is at each node
+	TArray<int> Segments;
+
+	bool IsValid() const { return Times.Num() > 1; }
+
+	/** True if built from a curve with NumKeys keys, one node per key other than the first and last plus node 0 */
+	bool IsBuiltFor(int NumKeys) const { return IsValid() && Times.Num() == NumKeys - 1; }
+
+	void Reset()
+	{
+		Times.Empty();
+		Segments.Empty();
+	}
+
+	/** Build from the curve's keys, whatever ShouldBuild says. Curves with fewer than three keys are left empty. @return IsValid() */
+	bool Build(const FRichCurve &Curve);
+
+	/** Same result as FCurviestCurveEval::FindSegment for InTime from the first key up to the last */
+	int FindSegment(float InTime) const;
+
+	SIZE_T GetAllocatedSize() const { return Times.GetAllocatedSize() + Segments.GetAllocatedSize(); }
+};
+
+/**
+ * One set of key times shared by several curves of an asset, with their segment coefficients interleaved so
+ * a single search finds the segment for all of them. Block [Segment][Power] holds one coefficient per curve.
+ */
+struct THECURVIESTCURVE_API FCurviestSharedTimeAxis
+{
+	TArray<float> Times;
+
+	// CurveData index of each curve on this axis, in the order of the coefficient blocks
+	TArray<int> Curves;
+
+	TArray<float> Coefficients;
+
+	/** Interleave the coefficients of CurveSegments, which must all be valid with identical Times */
+	void Build(TArrayView<const int> InCurves, TArrayView<const FCurviestSegmentCurve> CurveSegments);
+
+	/** Segment containing InTime, or INDEX_NONE outside [first key, last key) where each curve extrapolates on its own */
+	int FindSegment(float InTime) const;
+
+	/** Evaluate NumCurves curves on this axis from FirstCurve inside Segment, writing one value for each */
+	void EvalSegment(int Segment, float InTime, int FirstCurve, int NumCurves, float *ValuesOut) const;
+
+	SIZE_T GetAllocatedSize() const { return Times.GetAllocatedSize() + Curves.GetAllocatedSize() + Coefficients.GetAllocatedSize(); }
+};
+
+/**
+ * Key data of curves loaded from cooked assets, keyed by content hash, so identical curves in different assets are
+ * held once. Entries are freed with the last curve referencing them. Safe to use from the loading thread.
+ */
+class THECURVIESTCURVE_API FCurviestCurvePool
+{
+public:
+	typedef TSharedPtr<const FRichCurve, ESPMode::ThreadSafe> FCurvePtr;
+
+	static FCurviestCurvePool &Get();
+
+	/** Pooled curve equal to Curve, taking Curve as the pooled copy if there isn't one yet */
+	FCurvePtr Share(FRichCurve &&Curve, uint64 Hash);
+
+	/** Live pooled curves, the key bytes they hold, and the key bytes their references would hold unpooled */
+	void GetStats(int &NumCurvesOut, SIZE_T &PooledBytesOut, SIZE_T &ReferencedBytesOut) const;
+
+private:
+	mutable FCriticalSection Lock;
+	TMultiMap<uint64, TWeakPtr<const FRichCurve, ESPMode::ThreadSafe>> Curves;
+};
+
+/**
+ * Immutable data published through an atomic pointer and replaced as a whole. Readers on any thread hold it through a
+ * TCurviestSnapshotPin, and a replaced snapshot is retired rather than deleted so it is only freed once nothing pins it.
+ */
+struct THECURVIESTCURVE_API FCurviestSnapshot
+{
+	virtual ~FCurviestSnapshot() {}
+
+	/** Memory held, including the snapshot itself */
+	virtual SIZE_T GetAllocatedSize() const = 0;
+
+	/** Queue a snapshot no longer reachable from its pointer to be freed once unpinned. Owner only attributes its memory. */
+	static void Retire(const FCurviestSnapshot *Snapshot, const UObject *Owner);
+
+	/** Free retired snapshots nothing pins any more. Called whenever a snapshot is retired and at the end of every frame. */
+	static void ReclaimRetired();
+
+	/** Memory of Owner's retired snapshots still waiting for readers */
+	static SIZE_T GetRetiredSize(const UObject *Owner);
+
+	/** Stop attributing retired snapshots to an owner being destroyed. They stay queued for their readers. */
+	static void ForgetOwner(const UObject *Owner);
+
+	/**
+	 * The calling thread's hazard slot, registered on its first pin. A reader publishes the pointer it loaded here
+	 * until its pin count is raised, so reclaiming never frees a snapshot between the load and the pin. Each thread
+	 * writes only its own slot, so pinning shares no cache line with other readers except the snapshot's count.
+	 */
+	static std::atomic<const FCurviestSnapshot*> &GetThreadHazard();
+
+	mutable std::atomic<int32> PinCount { 0 };
+};
+
+/** Keeps a snapshot alive while held. Cheap to move, and copies pin again. */
+template <typename SnapshotType>
+class TCurviestSnapshotPin
+{
+public:
+	TCurviestSnapshotPin() {}
+
+	/** Pin whatever Source currently points at */
+	explicit TCurviestSnapshotPin(const std::atomic<const SnapshotType*> &Source)
+	{
+		// Sequentially consistent, so a reclaim that retired the pointer after this load either sees the hazard or
+		// the pin count, and otherwise the second load sees the replacement and the pin moves on to it
+		std::atomic<const FCurviestSnapshot*> &Hazard = FCurviestSnapshot::GetThreadHazard();
+		const SnapshotType *Loaded = Source.load(std::memory_order_acquire);
+		for (;;)
+		{
+			Hazard.store(Loaded);
+			const SnapshotType *Current = Source.load();
+			if (Current == Loaded)
+				break;
+			Loaded = Current;
+		}
+
+		Snapshot = Loaded;
+		if (Snapshot)
+			Snapshot->PinCount.fetch_add(1);
+		Hazard.store(nullptr, std::memory_order_release);
+	}
+
+	/** Pin a snapshot the caller already keeps alive, such as one it has just built or pinned */
+	explicit TCurviestSnapshotPin(const SnapshotType *InSnapshot)
+		: Snapshot(InSnapshot)
+	{
+		if (Snapshot)
+			Snapshot->PinCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	TCurviestSnapshotPin(const TCurviestSnapshotPin &Other) : TCurviestSnapshotPin(Other.Snapshot) {}
+
+	TCurviestSnapshotPin(TCurviestSnapshotPin &&Other)
+		: Snapshot(Other.Snapshot)
+	{
+		Other.Snapshot = nullptr;
+	}
+
+	TCurviestSnapshotPin &operator=(TCurviestSnapshotPin Other)
+	{
+		Swap(Snapshot, Other.Snapshot);
+		return *this;
+	}
+
+	~TCurviestSnapshotPin()
+	{
+		if (Snapshot)
+			Snapshot->PinCount.fetch_sub(1, std::memory_order_release);
+	}
+
+	bool IsValid() const { return Snapshot != nullptr; }
+	const SnapshotType *Get() const { return Snapshot; }
+	const SnapshotType &operator*() const { return *Snapshot; }
+	const SnapshotType *operator->() const { return Snapshot; }
+
+private:
+	const SnapshotType *Snapshot = nullptr;
+};
+
+/**
+ * Remembers the key segment a curve was last evaluated in. Callers that move time forward keep one per
+ * curve or handle so the next evaluation scans a few keys ahead instead of binary searching all of them.
+ */
+struct FCurviestEvalCursor
+{
+	// Index of the key that starts the last segment, INDEX_NONE before the first evaluation
+	int Segment = INDEX_NONE;
+};
+
+/** Key level evaluation helpers that give the same results as FRichCurve::Eval */
+struct THECURVIESTCURVE_API FCurviestCurveEval
+{
+	// How many segments a cursor walks forward before giving up and searching
+	static constexpr int MaxForwardScan = 4;
+
+	/** Same result as Curve.Eval(InTime), using Cursor to find the segment when time moves forward */
+	static float EvalWithCursor(const FRichCurve &Curve, float InTime, FCurviestEvalCursor &Cursor);
+
+	/** Index of the key starting the segment containing InTime, matching the search in FRichCurve::Eval */
+	static int FindSegment(const TArray<FRichCurveKey> &Keys, float InTime);
+
+	/** Same search as above over packed key times, without branches. NumTimes must be at least 2. */
+	static int FindSegment(const float *Times, int NumTimes, float InTime);
+
+	/** Evaluate between two keys the way FRichCurve does. Returns false for weighted tangents, which need the engine's solver. */
+	static bool EvalSegment(const FRichCurveKey &Key1, const FRichCurveKey &Key2, float InTime, float &ValueOut);
+
+	/** Hash of the keys, extrapolation and default value, so identical curves can be found without comparing keys */
+	static uint64 HashCurve(const FRichCurve &Curve);
+
+	/** Same for a cooked compressed curve */
+	static uint64 HashCurve(const FCurviestCompressedCurve &Curve);
+
+	// Times evaluated together by EvalMany, the width of a VectorRegister
+	static constexpr int NumLanes = 4;
+
+	/**
+	 * Same results as Curve.Eval for each of Times, NumLanes at a time with the segment searches interleaved and
+	 * the interpolation done in vector registers. Writes min(Times.Num(), ValuesOut.Num()) values.
+	 */
+	static void EvalMany(const FRichCurve &Curve, TArrayView<const float> Times, TArrayView<float> ValuesOut);
+
+	/** Run FindSegment for NumLanes times at once, stepping every search together without branches */
+	static void FindSegments(const TArray<FRichCurveKey> &Keys, const float *InTimes, int *SegmentsOut);
+
+	/** Same over packed key times. NumTimes must be at least 2. */
+	static void FindSegments(const float *Times, int NumTimes, const float *InTimes, int *SegmentsOut);
+
+	/** Sum += Values * Weight and WeightSum += Mask * Weight over Sum.Num() entries, NumLanes at a time */
+	static void AccumulateWeighted(TArrayView<float> Sum, TArrayView<float> WeightSum, const float *Values, const float *Mask, float Weight);
+
+	/** Sum /= WeightSum, or 0 where WeightSum is 0 */
+	static void NormalizeWeighted(TArrayView<float> Sum, TArrayView<const float> WeightSum);
+};
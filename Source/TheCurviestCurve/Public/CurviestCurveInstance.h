@@ -0,0 +1,174 @@
+// Copyright 2019 Skyler Clark. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "UObject/Object.h"
+#include "Curves/RichCurve.h"
+#include "GameplayTagContainer.h"
+#include "CurviestCurveEval.h"
+#include "Algo/BinarySearch.h"
+#include "CurviestCurveInstance.generated.h"
+
+class UCurveCurviest;
+struct FCurviestEvaluationSlot;
+struct FCurviestLookupSnapshot;
+
+/** Changes one tagged curve or param of the base asset for a single UCurviestCurveInstance */
+USTRUCT(BlueprintType)
+struct FCurviestCurveOverride
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Curviest")
+	FGameplayTag IdentifierTag;
+
+	// Evaluated instead of the base curve when it has keys. The authoritative copy; cooked builds drop the loaded
+	// keys once they are shared, until EditCurve copies them back.
+	UPROPERTY(EditAnywhere, Category = "Curviest")
+	FRichCurve Curve;
+
+	// Immutable copy of Curve as last published, so snapshots can reference it instead of copying
+	TSharedPtr<const FRichCurve, ESPMode::ThreadSafe> SharedCurve;
+
+	// Multiplies the time before the curve is evaluated
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Curviest")
+	float TimeScale = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Curviest")
+	float ValueScale = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Curviest")
+	float ValueOffset = 0.0f;
+};
+
+/** An override as a snapshot holds it: its scales and a reference to its keys, never a copy of them */
+struct FCurviestPublishedOverride
+{
+	FGameplayTag IdentifierTag;
+	TSharedPtr<const FRichCurve, ESPMode::ThreadSafe> Curve;
+	float TimeScale = 1.0f;
+	float ValueScale = 1.0f;
+	float ValueOffset = 0.0f;
+};
+
+/** Overrides resolved against one base layout. Replaced as a whole when they or the layout change, never modified in place. */
+struct FCurviestInstanceSnapshot : public FCurviestSnapshot
+{
+	TArray<FCurviestPublishedOverride> Overrides;
+
+	// Base evaluation slot and override index for each overridden slot, sorted by slot. Only used while the base
+	// layout still matches Epoch; otherwise overrides are matched by the tag of the slot.
+	TArray<TPair<int, int>> MergedSlots;
+	uint32 Epoch = 0;
+
+	/** Override of a base evaluation slot, through MergedSlots */
+	const FCurviestPublishedOverride *FindSlotOverride(int SlotIdx) const
+	{
+		const int MergedIdx = Algo::LowerBoundBy(MergedSlots, SlotIdx, [](const TPair<int, int> &Merged) { return Merged.Key; });
+		return MergedIdx < MergedSlots.Num() && MergedSlots[MergedIdx].Key == SlotIdx ? &Overrides[MergedSlots[MergedIdx].Value] : nullptr;
+	}
+
+	const FCurviestPublishedOverride *FindOverride(FGameplayTag IdentifierTag) const
+	{
+		return Overrides.FindByPredicate([IdentifierTag](const FCurviestPublishedOverride &Override) { return Override.IdentifierTag == IdentifierTag; });
+	}
+
+	virtual SIZE_T GetAllocatedSize() const override;
+};
+
+typedef TCurviestSnapshotPin<FCurviestInstanceSnapshot> FCurviestInstancePin;
+
+/**
+ * Per actor view of a UCurveCurviest that only stores what it changes. Lookups go to the base asset and the
+ * few overridden tags are patched on top, so many instances with small tweaks share one copy of the curves.
+ */
+UCLASS(BlueprintType)
+class THECURVIESTCURVE_API UCurviestCurveInstance : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Curviest")
+	UCurveCurviest *Base = nullptr;
+
+	UPROPERTY(EditAnywhere, Category = "Curviest")
+	TArray<FCurviestCurveOverride> Overrides;
+
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves")
+	void SetBase(UCurveCurviest *InBase);
+
+	/** Replace a param, or a curve with a constant */
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves")
+	void SetValueOverride(FGameplayTag IdentifierTag, float Value);
+
+	/** Scale and offset the values of a curve or param */
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves")
+	void SetValueScaleOverride(FGameplayTag IdentifierTag, float ValueScale, float ValueOffset = 0.0f);
+
+	/** Stretch a curve in time */
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves")
+	void SetTimeScaleOverride(FGameplayTag IdentifierTag, float TimeScale);
+
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves")
+	void ClearOverride(FGameplayTag IdentifierTag);
+
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves")
+	void ClearAllOverrides();
+
+	/**
+	 * Curve to edit keys on for this instance only, copied from the base curve the first time it is asked for. Null if
+	 * the tag isn't a curve. Overrides share one array, so the pointer is invalidated by the next override added or cleared.
+	 * Evaluation reads the published keys, so edits take effect at the next setter or RefreshMergedSlots, which
+	 * publishes a copy of them.
+	 */
+	FRichCurve *EditCurve(FGameplayTag IdentifierTag);
+
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves", meta = (BlueprintThreadSafe))
+	bool GetFloatValueFromTaggedCurve(FGameplayTag IdentifierTag, float InTime, float &ValueOut, bool bAllowParamLookup = true) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves", meta = (BlueprintThreadSafe))
+	bool GetFloatValueFromTaggedParam(FGameplayTag IdentifierTag, float &ValueOut) const;
+
+	/** Same slots as the base asset's EvaluateAllCurves, with overrides applied */
+	void EvaluateAllCurves(float InTime, TArrayView<float> ValuesOut) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Math|Curves", meta = (BlueprintThreadSafe, DisplayName = "Evaluate All Curves"))
+	void EvaluateAllCurvesToArray(float InTime, TArray<float> &ValuesOut) const;
+
+	/**
+	 * Publish the overrides resolved to the base asset's evaluation slots, which is all the getters read. Override keys
+	 * are copied into shared immutable curves only when they changed. Done by every setter, and by EvaluateAllCurves on the
+	 * game thread once the base layout has changed. Only needed after editing Overrides directly. Game thread only;
+	 * the replaced snapshot is freed like a lookup snapshot.
+	 */
+	void RefreshMergedSlots();
+
+	~UCurviestCurveInstance();
+
+	virtual void PostLoad() override;
+	virtual void Serialize(FArchive &Ar) override;
+
+#if WITH_EDITOR
+	virtual void PostEditUndo() override;
+	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& e) override;
+#endif
+
+protected:
+	FCurviestCurveOverride *FindOverride(FGameplayTag IdentifierTag);
+	FCurviestCurveOverride &FindOrAddOverride(FGameplayTag IdentifierTag);
+
+	/** Apply Override at InTime on top of the base slot it patches */
+	float EvalOverride(const FCurviestPublishedOverride &Override, const FCurviestEvaluationSlot &Slot, float InTime) const;
+
+	/** Resolve PublishedOverrides to the base asset's current slots and publish them as the new snapshot. Game thread only. */
+	void Publish(TArray<FCurviestPublishedOverride> &&PublishedOverrides) const;
+
+	/** Published override of Slot, through the merged slots while Current matches Lookups and by the slot's tag otherwise */
+	static const FCurviestPublishedOverride *FindSlotOverride(const FCurviestInstanceSnapshot &Current, const FCurviestLookupSnapshot &Lookups, const FCurviestEvaluationSlot &Slot);
+
+	// Published by RefreshMergedSlots and read from any thread, like UCurveCurviest's lookup snapshot
+	mutable std::atomic<const FCurviestInstanceSnapshot*> Snapshot { nullptr };
+};
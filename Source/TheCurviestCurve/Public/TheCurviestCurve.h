@@ -1,15 +1,27 @@
-// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Modules/ModuleManager.h"
-
-class FTheCurviestCurveModule : public IModuleInterface
-{
-public:
-
-	/** IModuleInterface implementation */
-	virtual void StartupModule() override;
-	virtual void ShutdownModule() override;
-};
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+#include "Stats/Stats.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogCurviestCurve, Log, All);
+DECLARE_STATS_GROUP(TEXT("CurviestCurve"), STATGROUP_CurviestCurve, STATCAT_Advanced);
+
+class FTheCurviestCurveModule : public IModuleInterface
+{
+public:
+
+	/** IModuleInterface implementation */
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+
+private:
+	FDelegateHandle EndFrameHandle;
+	FDelegateHandle TagTreeChangedRuntimeHandle;
+
+#if WITH_EDITOR
+	FDelegateHandle TagTreeChangedHandle;
+#endif
+};
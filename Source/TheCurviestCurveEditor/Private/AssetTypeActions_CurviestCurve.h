@@ -1,22 +1,22 @@
-// Copyright 2019 Skyler Clark. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Toolkits/IToolkitHost.h"
-#include <AssetTypeActions_Base.h>
-#include "CurviestCurve.h"
-
-class FAssetTypeActions_CurviestCurve : public FAssetTypeActions_Base
-{
-public:
-	// IAssetTypeActions Implementation
-	virtual FText GetName() const override { return NSLOCTEXT("AssetTypeActions", "AssetTypeActions_Curviest", "Curviest"); }
-	virtual FColor GetTypeColor() const override { return FColor(78, 40, 165); }
-	virtual UClass* GetSupportedClass() const override { return UCurveCurviest::StaticClass(); }
-	virtual void OpenAssetEditor(const TArray<UObject*>& InObjects, TSharedPtr<class IToolkitHost> EditWithinLevelEditor = TSharedPtr<IToolkitHost>()) override;
-	virtual bool CanFilter() override { return false; }
-	virtual uint32 GetCategories() override { return EAssetTypeCategories::Misc; }
-	virtual bool IsImportedAsset() const override { return true; }
-	virtual void GetResolvedSourceFilePaths(const TArray<UObject*>& TypeAssets, TArray<FString>& OutSourceFilePaths) const override;
-};
+// Copyright 2019 Skyler Clark. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Toolkits/IToolkitHost.h"
+#include <AssetTypeActions_Base.h>
+#include "CurviestCurve.h"
+
+class FAssetTypeActions_CurviestCurve : public FAssetTypeActions_Base
+{
+public:
+	// IAssetTypeActions Implementation
+	virtual FText GetName() const override { return NSLOCTEXT("AssetTypeActions", "AssetTypeActions_Curviest", "Curviest"); }
+	virtual FColor GetTypeColor() const override { return FColor(78, 40, 165); }
+	virtual UClass* GetSupportedClass() const override { return UCurveCurviest::StaticClass(); }
+	virtual void OpenAssetEditor(const TArray<UObject*>& InObjects, TSharedPtr<class IToolkitHost> EditWithinLevelEditor = TSharedPtr<IToolkitHost>()) override;
+	virtual bool CanFilter() override { return false; }
+	virtual uint32 GetCategories() override { return EAssetTypeCategories::Misc; }
+	virtual bool IsImportedAsset() const override { return true; }
+	virtual void GetResolvedSourceFilePaths(const TArray<UObject*>& TypeAssets, TArray<FString>& OutSourceFilePaths) const override;
+};
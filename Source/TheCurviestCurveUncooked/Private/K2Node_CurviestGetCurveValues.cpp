@@ -1,259 +1,366 @@
-// Copyright 2019 Skyler Clark. All Rights Reserved.
-
-#include "K2Node_CurviestGetCurveValues.h"
-
-#include "Curves/CurveVector.h"
-#include "Curves/CurveFloat.h"
-#include "Curves/CurveLinearColor.h"
-#include "CurviestCurve.h"
-#include "KismetCompiler.h"
-#include "BlueprintActionDatabaseRegistrar.h"
-#include "BlueprintNodeSpawner.h"
-#include "K2Node_CallFunction.h"
-#include "GraphEditorSettings.h"
-#include "Framework/MultiBox/MultiBoxBuilder.h"
-
-#if !(ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION < 24)
-#include "ToolMenus.h"
-#endif
-
-#define LOCTEXT_NAMESPACE "K2Node_Curviest"
-
-struct FGetPinName {
-
-	static const FName& GetTargetPin() {
-		static const FName PinName(TEXT("Target"));
-		return PinName;
-	}
-
-	static const FName& GetInTimePin() {
-		static const FName PinName(TEXT("InTime"));
-		return PinName;
-	}
-
-	static const FName& GetOutputPin1() {
-		static const FName OutputPinName(TEXT("Fred"));
-		return OutputPinName;
-	}
-
-	static const FName& GetOutputPin2() {
-		static const FName OutputPinName(TEXT("Carol"));
-		return OutputPinName;
-	}
-};
-
-void UK2Node_CurviestGetCurveValues::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
-{
-	bool bIsDirty = false;
-	FName PropertyName = (PropertyChangedEvent.Property != NULL) ? PropertyChangedEvent.Property->GetFName() : NAME_None;
-	if (PropertyName == TEXT("TemplateCurve"))
-	{
-		bIsDirty = true;
-	}
-
-	if (bIsDirty)
-	{
-		ReconstructNode();
-		GetGraph()->NotifyGraphChanged();
-	}
-
-	Super::PostEditChangeProperty(PropertyChangedEvent);
-}
-
-void UK2Node_CurviestGetCurveValues::AllocateDefaultPins()
-{
-	Super::AllocateDefaultPins();
-	const UEdGraphSchema_K2* K2Schema = GetDefault<UEdGraphSchema_K2>();
-
-	// Create our pins
-
-	// Input
-	UEdGraphPin* InTargetPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Object, UCurveBase::StaticClass(), FGetPinName::GetTargetPin());
-
-#if ENGINE_MAJOR_VERSION >= 5
-	UEdGraphPin* InValuePin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Real, UEdGraphSchema_K2::PC_Double, FGetPinName::GetInTimePin());
-#else
-	UEdGraphPin* InValuePin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Float, FGetPinName::GetInTimePin());
-#endif 
-
-	K2Schema->SetPinAutogeneratedDefaultValueBasedOnType(InValuePin);
-	
-	// Output
-
-	// Refresh
-	if (TemplateCurve)
-	{
-		OutCurveNames.Empty();
-		TArray<FRichCurveEditInfo> EditCurves = TemplateCurve->GetCurves();
-		for (FRichCurveEditInfo Elem : EditCurves)
-			OutCurveNames.Emplace(Elem.CurveName);
-	}
-
-
-	for (FName CurveName : OutCurveNames)
-	{
-#if ENGINE_MAJOR_VERSION >= 5
-		UEdGraphPin* OutValidPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Real, UEdGraphSchema_K2::PC_Double, CurveName);
-#else
-		UEdGraphPin* OutValidPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Float, CurveName);
-#endif 
-		OutValidPin->bAdvancedView = true;
-		K2Schema->SetPinAutogeneratedDefaultValueBasedOnType(OutValidPin);
-	}
-
-	if (ENodeAdvancedPins::NoPins == AdvancedPinDisplay)
-	{
-		AdvancedPinDisplay = ENodeAdvancedPins::Shown;
-	}
-}
-
-FText UK2Node_CurviestGetCurveValues::GetNodeTitle(ENodeTitleType::Type TitleType) const
-{
-	return LOCTEXT("K2Node_CurviestGetCurveValues_Title", "Get Curve Values");
-}
-
-FText UK2Node_CurviestGetCurveValues::GetTooltipText() const
-{
-	return LOCTEXT("K2Node_CurviestGetCurveValues_Tooltip", "Easily get float values out of any curve.");
-}
-
-FSlateIcon UK2Node_CurviestGetCurveValues::GetIconAndTint(FLinearColor& OutColor) const
-{
-	OutColor = GetDefault<UGraphEditorSettings>()->PureFunctionCallNodeTitleColor;
-	static FSlateIcon Icon("EditorStyle", "Kismet.AllClasses.FunctionIcon");
-	return Icon;
-}
-
-void UK2Node_CurviestGetCurveValues::PinDefaultValueChanged(UEdGraphPin* Pin)
-{
-	Super::PinDefaultValueChanged(Pin);
-
-	if (Pin == FindPin(FGetPinName::GetTargetPin()))
-	{
-		if (UCurveBase *Curve = Cast<UCurveBase>(Pin->DefaultObject))
-		{
-			TemplateCurve = Curve;
-			PreloadObject(TemplateCurve);
-			TemplateCurve->ConditionalPostLoad();
-
-			RefreshTemplateCurve();
-		}
-	}
-}
-
-void UK2Node_CurviestGetCurveValues::PreloadRequiredAssets()
-{
-	Super::PreloadRequiredAssets();
-
-	PreloadObject(TemplateCurve);
-}
-
-
-FText UK2Node_CurviestGetCurveValues::GetMenuCategory() const
-{
-	return LOCTEXT("K2Node_CurviestGetCurveValues_MenuCategory", "Curves");
-}
-
-void UK2Node_CurviestGetCurveValues::ExpandNode(class FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
-{
-	Super::ExpandNode(CompilerContext, SourceGraph);
-
-	UFunction* Func_GetValueFromCurve = UCurveCurviestBlueprintUtils::StaticClass()->FindFunctionByName(FName(TEXT("GetValueFromCurve")));
-	
-	const UEdGraphSchema_K2* K2Schema = GetDefault<UEdGraphSchema_K2>();
-
-	for (FName CurveName : OutCurveNames)
-	{
-		UK2Node_CallFunction* CallFuncNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
-		CallFuncNode->SetFromFunction(Func_GetValueFromCurve);
-		CallFuncNode->AllocateDefaultPins();
-
-		CompilerContext.MessageLog.NotifyIntermediateObjectCreation(CallFuncNode, this);
-
-		//Input
-		CompilerContext.CopyPinLinksToIntermediate(*FindPin(FGetPinName::GetTargetPin()), *CallFuncNode->FindPin(TEXT("Curve")));
-
-		UEdGraphPin* NamePin = CallFuncNode->FindPin(TEXT("Name"));
-		K2Schema->SetPinAutogeneratedDefaultValue(NamePin, CurveName.ToString());
-
-		CompilerContext.CopyPinLinksToIntermediate(*FindPin(FGetPinName::GetInTimePin()), *CallFuncNode->FindPin(TEXT("InTime")));
-
-		//Output
-		CompilerContext.MovePinLinksToIntermediate(*FindPin(CurveName), *CallFuncNode->GetReturnValuePin());
-	}
-
-	BreakAllNodeLinks();
-}
-
-
-//This method adds our node to the context menu
-void UK2Node_CurviestGetCurveValues::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
-{
-	Super::GetMenuActions(ActionRegistrar);
-
-	UClass* Action = GetClass();
-
-	if (ActionRegistrar.IsOpenForRegistration(Action)) {
-		UBlueprintNodeSpawner* Spawner = UBlueprintNodeSpawner::Create(GetClass());
-		check(Spawner != nullptr);
-
-		ActionRegistrar.AddBlueprintAction(Action, Spawner);
-	}
-}
-
-#if ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION < 24
-void UK2Node_CurviestGetCurveValues::GetContextMenuActions(const FGraphNodeContextMenuBuilder& Context) const
-{
-	Super::GetContextMenuActions(Context);
-
-	Context.MenuBuilder->BeginSection("K2NodeVariableGet", LOCTEXT("K2Node_CurviestGetCurveValues_Header", "Curviest"));
-	{
-		Context.MenuBuilder->AddMenuEntry(
-			LOCTEXT("RefreshNode", "Refresh Node"), 
-			LOCTEXT("RefreshNodeTooltip", "Refresh this node."),
-			FSlateIcon(),
-			FUIAction(
-				FExecuteAction::CreateUObject(this, &UK2Node_CurviestGetCurveValues::RefreshTemplateCurve),
-				FCanExecuteAction(),
-				FIsActionChecked()
-			)
-		);
-	}
-
-	Context.MenuBuilder->EndSection();
-}
-#else
-void UK2Node_CurviestGetCurveValues::GetNodeContextMenuActions(UToolMenu* Menu, UGraphNodeContextMenuContext* Context) const
-{
-	Super::GetNodeContextMenuActions(Menu, Context);
-
-	FToolMenuSection& Section = Menu->AddSection("K2NodeCurviestGetCurveValues", LOCTEXT("CurviestGetCurveValuesHeader", "Curviest"));
-	Section.AddMenuEntry(
-		"RefreshNode",
-		LOCTEXT("RefreshNode", "Refresh Node"),
-		LOCTEXT("RefreshNodeTooltip", "Refresh this node."),
-		FSlateIcon(),
-		FUIAction(
-			FExecuteAction::CreateUObject(const_cast<UK2Node_CurviestGetCurveValues*>(this), &UK2Node_CurviestGetCurveValues::RefreshTemplateCurve),
-			FCanExecuteAction(),
-			FIsActionChecked()
-		)
-	);
-}
-#endif
-
-void UK2Node_CurviestGetCurveValues::RefreshTemplateCurve()
-{
-	if (TemplateCurve)
-	{
-		OutCurveNames.Empty();
-		TArray<FRichCurveEditInfo> EditCurves = TemplateCurve->GetCurves();
-		for (FRichCurveEditInfo Elem : EditCurves)
-			OutCurveNames.Emplace(Elem.CurveName);
-	}
-
-	ReconstructNode();
-	GetGraph()->NotifyGraphChanged();
-}
-
+// Copyright 2019 Skyler Clark. All Rights Reserved.
+
+#include "K2Node_CurviestGetCurveValues.h"
+
+#include "Curves/CurveVector.h"
+#include "Curves/CurveFloat.h"
+#include "Curves/CurveLinearColor.h"
+#include "CurviestCurve.h"
+#include "KismetCompiler.h"
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "BlueprintNodeSpawner.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_GetArrayItem.h"
+#include "K2Node_TemporaryVariable.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "ScopedTransaction.h"
+#include "GraphEditorSettings.h"
+#include "Framework/MultiBox/MultiBoxBuilder.h"
+
+#if !(ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION < 24)
+#include "ToolMenus.h"
+#endif
+
+#define LOCTEXT_NAMESPACE "K2Node_Curviest"
+
+struct FGetPinName {
+
+	static const FName& GetTargetPin() {
+		static const FName PinName(TEXT("Target"));
+		return PinName;
+	}
+
+	static const FName& GetInTimePin() {
+		static const FName PinName(TEXT("InTime"));
+		return PinName;
+	}
+
+	static const FName& GetOutputPin1() {
+		static const FName OutputPinName(TEXT("Fred"));
+		return OutputPinName;
+	}
+
+	static const FName& GetOutputPin2() {
+		static const FName OutputPinName(TEXT("Carol"));
+		return OutputPinName;
+	}
+};
+
+void UK2Node_CurviestGetCurveValues::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
+{
+	bool bIsDirty = false;
+	FName PropertyName = (PropertyChangedEvent.Property != NULL) ? PropertyChangedEvent.Property->GetFName() : NAME_None;
+	if (PropertyName == TEXT("TemplateCurve"))
+	{
+		bIsDirty = true;
+	}
+
+	if (bIsDirty)
+	{
+		ReconstructNode();
+		GetGraph()->NotifyGraphChanged();
+	}
+
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+}
+
+void UK2Node_CurviestGetCurveValues::AllocateDefaultPins()
+{
+	Super::AllocateDefaultPins();
+	const UEdGraphSchema_K2* K2Schema = GetDefault<UEdGraphSchema_K2>();
+
+	// Create our pins
+	if (!bIsPureNode)
+	{
+		CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute);
+		CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Then);
+	}
+
+	// Input
+	UEdGraphPin* InTargetPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Object, UCurveBase::StaticClass(), FGetPinName::GetTargetPin());
+
+#if ENGINE_MAJOR_VERSION >= 5
+	UEdGraphPin* InValuePin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Real, UEdGraphSchema_K2::PC_Double, FGetPinName::GetInTimePin());
+#else
+	UEdGraphPin* InValuePin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Float, FGetPinName::GetInTimePin());
+#endif 
+
+	K2Schema->SetPinAutogeneratedDefaultValueBasedOnType(InValuePin);
+	
+	// Output
+
+	// Refresh
+	if (TemplateCurve)
+	{
+		OutCurveNames.Empty();
+		TArray<FRichCurveEditInfo> EditCurves = TemplateCurve->GetCurves();
+		for (FRichCurveEditInfo Elem : EditCurves)
+			OutCurveNames.Emplace(Elem.CurveName);
+	}
+
+
+	for (FName CurveName : OutCurveNames)
+	{
+#if ENGINE_MAJOR_VERSION >= 5
+		UEdGraphPin* OutValidPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Real, UEdGraphSchema_K2::PC_Double, CurveName);
+#else
+		UEdGraphPin* OutValidPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Float, CurveName);
+#endif 
+		OutValidPin->bAdvancedView = true;
+		K2Schema->SetPinAutogeneratedDefaultValueBasedOnType(OutValidPin);
+	}
+
+	if (ENodeAdvancedPins::NoPins == AdvancedPinDisplay)
+	{
+		AdvancedPinDisplay = ENodeAdvancedPins::Shown;
+	}
+}
+
+FText UK2Node_CurviestGetCurveValues::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("K2Node_CurviestGetCurveValues_Title", "Get Curve Values");
+}
+
+FText UK2Node_CurviestGetCurveValues::GetTooltipText() const
+{
+	return LOCTEXT("K2Node_CurviestGetCurveValues_Tooltip", "Easily get float values out of any curve.");
+}
+
+FSlateIcon UK2Node_CurviestGetCurveValues::GetIconAndTint(FLinearColor& OutColor) const
+{
+	OutColor = bIsPureNode ? GetDefault<UGraphEditorSettings>()->PureFunctionCallNodeTitleColor : GetDefault<UGraphEditorSettings>()->FunctionCallNodeTitleColor;
+	static FSlateIcon Icon("EditorStyle", "Kismet.AllClasses.FunctionIcon");
+	return Icon;
+}
+
+void UK2Node_CurviestGetCurveValues::PinDefaultValueChanged(UEdGraphPin* Pin)
+{
+	Super::PinDefaultValueChanged(Pin);
+
+	if (Pin == FindPin(FGetPinName::GetTargetPin()))
+	{
+		if (UCurveBase *Curve = Cast<UCurveBase>(Pin->DefaultObject))
+		{
+			TemplateCurve = Curve;
+			PreloadObject(TemplateCurve);
+			TemplateCurve->ConditionalPostLoad();
+
+			RefreshTemplateCurve();
+		}
+	}
+}
+
+void UK2Node_CurviestGetCurveValues::PreloadRequiredAssets()
+{
+	Super::PreloadRequiredAssets();
+
+	PreloadObject(TemplateCurve);
+}
+
+
+FText UK2Node_CurviestGetCurveValues::GetMenuCategory() const
+{
+	return LOCTEXT("K2Node_CurviestGetCurveValues_MenuCategory", "Curves");
+}
+
+void UK2Node_CurviestGetCurveValues::ExpandNode(class FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	const UEdGraphSchema_K2* K2Schema = GetDefault<UEdGraphSchema_K2>();
+
+	// The linked curve names are baked into an object owned by the generated class and passed as a literal, so
+	// the call never builds a name list at runtime
+	UCurviestCurveValueList* ValueList = NewObject<UCurviestCurveValueList>(CompilerContext.NewClass, MakeUniqueObjectName(CompilerContext.NewClass, UCurviestCurveValueList::StaticClass()));
+	TArray<UEdGraphPin*> LinkedOutPins;
+	for (FName CurveName : OutCurveNames)
+	{
+		UEdGraphPin* OutPin = FindPin(CurveName);
+		if (OutPin && OutPin->LinkedTo.Num() > 0)
+		{
+			ValueList->Names.Add(CurveName);
+			LinkedOutPins.Add(OutPin);
+		}
+	}
+	ValueList->ResolveSlots(Cast<UCurveCurviest>(TemplateCurve));
+
+	// Without exec pins each linked output gets its own pure call for its entry, so a read only evaluates the
+	// curve it needs. With exec pins one native call evaluates every linked curve into a temporary, and each output
+	// reads its element with an array get. In event graphs that temporary persists on the object and keeps its
+	// allocation, but in function graphs it is a local, so each call still allocates it once.
+	if (bIsPureNode)
+	{
+		UFunction* Func_GetValueFromValueList = UCurveCurviestBlueprintUtils::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UCurveCurviestBlueprintUtils, GetValueFromValueList));
+		for (int CurveIdx = 0; CurveIdx < LinkedOutPins.Num(); CurveIdx++)
+		{
+			UK2Node_CallFunction* CallFuncNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+			CallFuncNode->SetFromFunction(Func_GetValueFromValueList);
+			CallFuncNode->AllocateDefaultPins();
+
+			CompilerContext.MessageLog.NotifyIntermediateObjectCreation(CallFuncNode, this);
+
+			//Input
+			CompilerContext.CopyPinLinksToIntermediate(*FindPin(FGetPinName::GetTargetPin()), *CallFuncNode->FindPin(TEXT("Curve")));
+			K2Schema->TrySetDefaultObject(*CallFuncNode->FindPin(TEXT("ValueList")), ValueList);
+			K2Schema->SetPinAutogeneratedDefaultValue(CallFuncNode->FindPin(TEXT("Index")), FString::FromInt(CurveIdx));
+			CompilerContext.CopyPinLinksToIntermediate(*FindPin(FGetPinName::GetInTimePin()), *CallFuncNode->FindPin(TEXT("InTime")));
+
+			//Output
+			CompilerContext.MovePinLinksToIntermediate(*LinkedOutPins[CurveIdx], *CallFuncNode->GetReturnValuePin());
+		}
+
+		BreakAllNodeLinks();
+		return;
+	}
+
+	UFunction* Func_EvaluateValuesFromCurve = UCurveCurviestBlueprintUtils::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UCurveCurviestBlueprintUtils, EvaluateValuesFromCurve));
+	UK2Node_CallFunction* CallFuncNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	CallFuncNode->SetFromFunction(Func_EvaluateValuesFromCurve);
+	CallFuncNode->AllocateDefaultPins();
+
+	CompilerContext.MessageLog.NotifyIntermediateObjectCreation(CallFuncNode, this);
+
+	//Input
+	CompilerContext.CopyPinLinksToIntermediate(*FindPin(FGetPinName::GetTargetPin()), *CallFuncNode->FindPin(TEXT("Curve")));
+
+	UEdGraphPin* ValueListPin = CallFuncNode->FindPin(TEXT("ValueList"));
+	K2Schema->TrySetDefaultObject(*ValueListPin, ValueList);
+
+	CompilerContext.CopyPinLinksToIntermediate(*FindPin(FGetPinName::GetInTimePin()), *CallFuncNode->FindPin(TEXT("InTime")));
+
+	//Output
+	UEdGraphPin* ValuesPin = CallFuncNode->FindPin(TEXT("Values"));
+	UK2Node_TemporaryVariable* ValuesNode = CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(this, SourceGraph);
+	ValuesNode->VariableType = ValuesPin->PinType;
+	ValuesNode->VariableType.bIsReference = false;
+	ValuesNode->AllocateDefaultPins();
+
+	CompilerContext.MessageLog.NotifyIntermediateObjectCreation(ValuesNode, this);
+
+	K2Schema->TryCreateConnection(ValuesNode->GetVariablePin(), ValuesPin);
+	ValuesPin = ValuesNode->GetVariablePin();
+
+	CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *CallFuncNode->GetExecPin());
+	CompilerContext.MovePinLinksToIntermediate(*GetThenPin(), *CallFuncNode->GetThenPin());
+
+	for (int CurveIdx = 0; CurveIdx < LinkedOutPins.Num(); CurveIdx++)
+	{
+		UK2Node_GetArrayItem* GetItemNode = CompilerContext.SpawnIntermediateNode<UK2Node_GetArrayItem>(this, SourceGraph);
+		GetItemNode->AllocateDefaultPins();
+
+		CompilerContext.MessageLog.NotifyIntermediateObjectCreation(GetItemNode, this);
+
+		K2Schema->TryCreateConnection(ValuesPin, GetItemNode->GetTargetArrayPin());
+		K2Schema->SetPinAutogeneratedDefaultValue(GetItemNode->GetIndexPin(), FString::FromInt(CurveIdx));
+
+		CompilerContext.MovePinLinksToIntermediate(*LinkedOutPins[CurveIdx], *GetItemNode->GetResultPin());
+	}
+
+	BreakAllNodeLinks();
+}
+
+
+//This method adds our node to the context menu
+void UK2Node_CurviestGetCurveValues::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	Super::GetMenuActions(ActionRegistrar);
+
+	UClass* Action = GetClass();
+
+	if (ActionRegistrar.IsOpenForRegistration(Action)) {
+		UBlueprintNodeSpawner* Spawner = UBlueprintNodeSpawner::Create(GetClass());
+		check(Spawner != nullptr);
+
+		ActionRegistrar.AddBlueprintAction(Action, Spawner);
+	}
+}
+
+#if ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION < 24
+void UK2Node_CurviestGetCurveValues::GetContextMenuActions(const FGraphNodeContextMenuBuilder& Context) const
+{
+	Super::GetContextMenuActions(Context);
+
+	Context.MenuBuilder->BeginSection("K2NodeVariableGet", LOCTEXT("K2Node_CurviestGetCurveValues_Header", "Curviest"));
+	{
+		Context.MenuBuilder->AddMenuEntry(
+			LOCTEXT("RefreshNode", "Refresh Node"), 
+			LOCTEXT("RefreshNodeTooltip", "Refresh this node."),
+			FSlateIcon(),
+			FUIAction(
+				FExecuteAction::CreateUObject(this, &UK2Node_CurviestGetCurveValues::RefreshTemplateCurve),
+				FCanExecuteAction(),
+				FIsActionChecked()
+			)
+		);
+		Context.MenuBuilder->AddMenuEntry(
+			bIsPureNode ? LOCTEXT("ConvertToImpure", "Convert to Impure") : LOCTEXT("ConvertToPure", "Convert to Pure"),
+			bIsPureNode ? LOCTEXT("ConvertToImpureTooltip", "Add exec pins, so the curves are evaluated once per execution however many nodes read the outputs.")
+				: LOCTEXT("ConvertToPureTooltip", "Remove the exec pins. Each output evaluates its own curve whenever it is read."),
+			FSlateIcon(),
+			FUIAction(
+				FExecuteAction::CreateUObject(const_cast<UK2Node_CurviestGetCurveValues*>(this), &UK2Node_CurviestGetCurveValues::TogglePurity),
+				FCanExecuteAction(),
+				FIsActionChecked()
+			)
+		);
+	}
+
+	Context.MenuBuilder->EndSection();
+}
+#else
+void UK2Node_CurviestGetCurveValues::GetNodeContextMenuActions(UToolMenu* Menu, UGraphNodeContextMenuContext* Context) const
+{
+	Super::GetNodeContextMenuActions(Menu, Context);
+
+	FToolMenuSection& Section = Menu->AddSection("K2NodeCurviestGetCurveValues", LOCTEXT("CurviestGetCurveValuesHeader", "Curviest"));
+	Section.AddMenuEntry(
+		"RefreshNode",
+		LOCTEXT("RefreshNode", "Refresh Node"),
+		LOCTEXT("RefreshNodeTooltip", "Refresh this node."),
+		FSlateIcon(),
+		FUIAction(
+			FExecuteAction::CreateUObject(const_cast<UK2Node_CurviestGetCurveValues*>(this), &UK2Node_CurviestGetCurveValues::RefreshTemplateCurve),
+			FCanExecuteAction(),
+			FIsActionChecked()
+		)
+	);
+	Section.AddMenuEntry(
+		"TogglePurity",
+		bIsPureNode ? LOCTEXT("ConvertToImpure", "Convert to Impure") : LOCTEXT("ConvertToPure", "Convert to Pure"),
+		bIsPureNode ? LOCTEXT("ConvertToImpureTooltip", "Add exec pins, so the curves are evaluated once per execution however many nodes read the outputs.")
+			: LOCTEXT("ConvertToPureTooltip", "Remove the exec pins. Each output evaluates its own curve whenever it is read."),
+		FSlateIcon(),
+		FUIAction(
+			FExecuteAction::CreateUObject(const_cast<UK2Node_CurviestGetCurveValues*>(this), &UK2Node_CurviestGetCurveValues::TogglePurity),
+			FCanExecuteAction(),
+			FIsActionChecked()
+		)
+	);
+}
+#endif
+
+void UK2Node_CurviestGetCurveValues::RefreshTemplateCurve()
+{
+	if (TemplateCurve)
+	{
+		OutCurveNames.Empty();
+		TArray<FRichCurveEditInfo> EditCurves = TemplateCurve->GetCurves();
+		for (FRichCurveEditInfo Elem : EditCurves)
+			OutCurveNames.Emplace(Elem.CurveName);
+	}
+
+	ReconstructNode();
+	GetGraph()->NotifyGraphChanged();
+}
+
+void UK2Node_CurviestGetCurveValues::TogglePurity()
+{
+	const FScopedTransaction Transaction(bIsPureNode ? LOCTEXT("ConvertToImpureTransaction", "Convert to Impure") : LOCTEXT("ConvertToPureTransaction", "Convert to Pure"));
+	Modify();
+
+	bIsPureNode = !bIsPureNode;
+	ReconstructNode();
+	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -1,224 +1,321 @@
-// Copyright 2019 Skyler Clark. All Rights Reserved.
-
-#include "K2Node_CurviestGetTaggedCurveValues.h"
-
-#include "Curves/CurveVector.h"
-#include "Curves/CurveFloat.h"
-#include "Curves/CurveLinearColor.h"
-#include "CurviestCurve.h"
-#include "KismetCompiler.h"
-#include "BlueprintActionDatabaseRegistrar.h"
-#include "BlueprintNodeSpawner.h"
-#include "K2Node_CallFunction.h"
-#include "GraphEditorSettings.h"
-#include "Framework/MultiBox/MultiBoxBuilder.h"
-
-#if ENGINE_MINOR_VERSION >= 24
-#include "ToolMenus.h"
-#endif
-
-#define LOCTEXT_NAMESPACE "K2Node_Curviest"
-
-struct FTaggedCurveValuesGetPinName {
-
-	static const FName& GetTargetPin() {
-		static const FName PinName(TEXT("Target"));
-		return PinName;
-	}
-
-	static const FName& GetInTimePin() {
-		static const FName PinName(TEXT("InTime"));
-		return PinName;
-	}
-
-	static const FName& GetTagsPin() {
-		static const FName PinName(TEXT("Tags"));
-		return PinName;
-	}
-
-	static const FName& GetAllowParamLookupPin() {
-		static const FName PinName(TEXT("bAllowParamLookup"));
-		return PinName;
-	}
-};
-
-void UK2Node_CurviestGetTaggedCurveValues::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
-{
-	bool bIsDirty = false;
-	FName PropertyName = (PropertyChangedEvent.Property != NULL) ? PropertyChangedEvent.Property->GetFName() : NAME_None;
-	if (PropertyName == TEXT("Tags") || PropertyName == TEXT("bAllowParamLookup"))
-	{
-		bIsDirty = true;
-	}
-
-	if (bIsDirty)
-	{
-		ReconstructNode();
-		GetGraph()->NotifyGraphChanged();
-	}
-
-	Super::PostEditChangeProperty(PropertyChangedEvent);
-}
-
-void UK2Node_CurviestGetTaggedCurveValues::AllocateDefaultPins()
-{
-	Super::AllocateDefaultPins();
-	const UEdGraphSchema_K2* K2Schema = GetDefault<UEdGraphSchema_K2>();
-
-	// Create our pins
-
-	// Input
-	UEdGraphPin* InTargetPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Object, UCurveBase::StaticClass(), FTaggedCurveValuesGetPinName::GetTargetPin());
-	
-#if ENGINE_MAJOR_VERSION >= 5
-	UEdGraphPin* InValuePin = CreatePin(EGPD_Input,  UEdGraphSchema_K2::PC_Real, UEdGraphSchema_K2::PC_Double, FTaggedCurveValuesGetPinName::GetInTimePin());
-#else
-	UEdGraphPin* InValuePin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Float, FTaggedCurveValuesGetPinName::GetInTimePin());
-#endif 
-	K2Schema->SetPinAutogeneratedDefaultValueBasedOnType(InValuePin);
-
-	UEdGraphPin* TagsPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Struct, FGameplayTagContainer::StaticStruct(), FTaggedCurveValuesGetPinName::GetTagsPin());
-	K2Schema->SetPinAutogeneratedDefaultValue(TagsPin, Tags.ToString());
-	TagsPin->bAdvancedView = true;
-
-	UEdGraphPin* AllowParamLookupPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Boolean, FTaggedCurveValuesGetPinName::GetAllowParamLookupPin());
-	K2Schema->SetPinAutogeneratedDefaultValue(AllowParamLookupPin, bAllowParamLookup ? TEXT("true") : TEXT("false"));
-	AllowParamLookupPin->bAdvancedView = true;
-
-	// Output
-
-	// Refresh
-	for (FGameplayTag Tag : Tags)
-	{
-#if ENGINE_MAJOR_VERSION >= 5
-		UEdGraphPin* OutValidPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Real, UEdGraphSchema_K2::PC_Double, Tag.GetTagName());
-#else
-		UEdGraphPin* OutValidPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Float, Tag.GetTagName());
-#endif 
-		//OutValidPin->bAdvancedView = true;
-		K2Schema->SetPinAutogeneratedDefaultValueBasedOnType(OutValidPin);
-	}
-
-	if (ENodeAdvancedPins::NoPins == AdvancedPinDisplay)
-	{
-		AdvancedPinDisplay = ENodeAdvancedPins::Shown;
-	}
-}
-
-FText UK2Node_CurviestGetTaggedCurveValues::GetNodeTitle(ENodeTitleType::Type TitleType) const
-{
-	return LOCTEXT("K2Node_CurviestGetTaggedCurveValues_Title", "Get Tagged Curve Values");
-}
-
-FText UK2Node_CurviestGetTaggedCurveValues::GetTooltipText() const
-{
-	return LOCTEXT("K2Node_CurviestGetCurveValues_Tooltip", "Easily get float values out of any curve.");
-}
-
-FSlateIcon UK2Node_CurviestGetTaggedCurveValues::GetIconAndTint(FLinearColor& OutColor) const
-{
-	OutColor = GetDefault<UGraphEditorSettings>()->PureFunctionCallNodeTitleColor;
-	static FSlateIcon Icon("EditorStyle", "Kismet.AllClasses.FunctionIcon");
-	return Icon;
-}
-
-void UK2Node_CurviestGetTaggedCurveValues::PinDefaultValueChanged(UEdGraphPin* Pin)
-{
-	Super::PinDefaultValueChanged(Pin);
-
-	if (Pin == FindPin(FTaggedCurveValuesGetPinName::GetTagsPin()))
-	{
-		Tags.FromExportString(Pin->DefaultValue);
-
-		ReconstructNode();
-		GetGraph()->NotifyGraphChanged();
-	}
-	else if (Pin == FindPin(FTaggedCurveValuesGetPinName::GetAllowParamLookupPin()))
-	{
-		bAllowParamLookup = Pin->DefaultValue == TEXT("true");
-	}
-}
-
-void UK2Node_CurviestGetTaggedCurveValues::PreloadRequiredAssets()
-{
-	Super::PreloadRequiredAssets();
-}
-
-
-FText UK2Node_CurviestGetTaggedCurveValues::GetMenuCategory() const
-{
-	return LOCTEXT("K2Node_CurviestGetCurveValues_MenuCategory", "Curves");
-}
-
-void UK2Node_CurviestGetTaggedCurveValues::ExpandNode(class FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
-{
-	Super::ExpandNode(CompilerContext, SourceGraph);
-
-	UFunction* Func_GetValueFromCurve = UCurveCurviestBlueprintUtils::StaticClass()->FindFunctionByName(FName(TEXT("GetValueFromTaggedCurve")));
-	
-	const UEdGraphSchema_K2* K2Schema = GetDefault<UEdGraphSchema_K2>();
-
-	for (FGameplayTag Tag : Tags)
-	{
-		FName CurveName = Tag.GetTagName();
-
-		UK2Node_CallFunction* CallFuncNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
-		CallFuncNode->SetFromFunction(Func_GetValueFromCurve);
-		CallFuncNode->AllocateDefaultPins();
-
-		CompilerContext.MessageLog.NotifyIntermediateObjectCreation(CallFuncNode, this);
-
-		//Input
-		CompilerContext.CopyPinLinksToIntermediate(*FindPin(FTaggedCurveValuesGetPinName::GetTargetPin()), *CallFuncNode->FindPin(TEXT("Curve")));
-
-		UEdGraphPin* TagPin = CallFuncNode->FindPin(TEXT("Tag"));		
-		K2Schema->SetPinAutogeneratedDefaultValue(TagPin, CurveName.ToString());
-
-		UEdGraphPin* AllowParamLookupPin = CallFuncNode->FindPin(TEXT("bAllowParamLookup"));
-		K2Schema->SetPinAutogeneratedDefaultValue(AllowParamLookupPin, bAllowParamLookup ? "true" : "false" );
-
-		CompilerContext.CopyPinLinksToIntermediate(*FindPin(FTaggedCurveValuesGetPinName::GetInTimePin()), *CallFuncNode->FindPin(TEXT("InTime")));
-
-		//Output
-		CompilerContext.MovePinLinksToIntermediate(*FindPin(CurveName), *CallFuncNode->GetReturnValuePin());
-	}
-
-	BreakAllNodeLinks();
-}
-
-
-//This method adds our node to the context menu
-void UK2Node_CurviestGetTaggedCurveValues::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
-{
-	Super::GetMenuActions(ActionRegistrar);
-
-	UClass* Action = GetClass();
-
-	if (ActionRegistrar.IsOpenForRegistration(Action)) {
-		UBlueprintNodeSpawner* Spawner = UBlueprintNodeSpawner::Create(GetClass());
-		check(Spawner != nullptr);
-
-		ActionRegistrar.AddBlueprintAction(Action, Spawner);
-	}
-}
-
-void UK2Node_CurviestGetTaggedCurveValues::GetNodeContextMenuActions(UToolMenu* Menu, UGraphNodeContextMenuContext* Context) const
-{
-	Super::GetNodeContextMenuActions(Menu, Context);
-	/*
-	FToolMenuSection& Section = Menu->AddSection("K2NodeCurviestGetCurveValues", LOCTEXT("CurviestGetCurveValuesHeader", "Curviest"));
-	Section.AddMenuEntry(
-		"RefreshNode",
-		LOCTEXT("RefreshNode", "Refresh Node"),
-		LOCTEXT("RefreshNodeTooltip", "Refresh this node."),
-		FSlateIcon(),
-		FUIAction(
-			FExecuteAction::CreateUObject(const_cast<UK2Node_CurviestGetTaggedCurveValues*>(this), &UK2Node_CurviestGetTaggedCurveValues::RefreshTemplateCurve),
-			FCanExecuteAction(),
-			FIsActionChecked()
-		)
-	);*/
-}
-
-
+// Copyright 2019 Skyler Clark. All Rights Reserved.
+
+#include "K2Node_CurviestGetTaggedCurveValues.h"
+
+#include "Curves/CurveVector.h"
+#include "Curves/CurveFloat.h"
+#include "Curves/CurveLinearColor.h"
+#include "CurviestCurve.h"
+#include "KismetCompiler.h"
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "BlueprintNodeSpawner.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_GetArrayItem.h"
+#include "K2Node_TemporaryVariable.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "ScopedTransaction.h"
+#include "GraphEditorSettings.h"
+#include "Framework/MultiBox/MultiBoxBuilder.h"
+
+#if !(ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION < 24)
+#include "ToolMenus.h"
+#endif
+
+#define LOCTEXT_NAMESPACE "K2Node_Curviest"
+
+struct FTaggedCurveValuesGetPinName {
+
+	static const FName& GetTargetPin() {
+		static const FName PinName(TEXT("Target"));
+		return PinName;
+	}
+
+	static const FName& GetInTimePin() {
+		static const FName PinName(TEXT("InTime"));
+		return PinName;
+	}
+
+	static const FName& GetTagsPin() {
+		static const FName PinName(TEXT("Tags"));
+		return PinName;
+	}
+
+	static const FName& GetAllowParamLookupPin() {
+		static const FName PinName(TEXT("bAllowParamLookup"));
+		return PinName;
+	}
+};
+
+void UK2Node_CurviestGetTaggedCurveValues::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
+{
+	bool bIsDirty = false;
+	FName PropertyName = (PropertyChangedEvent.Property != NULL) ? PropertyChangedEvent.Property->GetFName() : NAME_None;
+	if (PropertyName == TEXT("Tags") || PropertyName == TEXT("bAllowParamLookup"))
+	{
+		bIsDirty = true;
+	}
+
+	if (bIsDirty)
+	{
+		ReconstructNode();
+		GetGraph()->NotifyGraphChanged();
+	}
+
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+}
+
+void UK2Node_CurviestGetTaggedCurveValues::AllocateDefaultPins()
+{
+	Super::AllocateDefaultPins();
+	const UEdGraphSchema_K2* K2Schema = GetDefault<UEdGraphSchema_K2>();
+
+	// Create our pins
+	if (!bIsPureNode)
+	{
+		CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute);
+		CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Then);
+	}
+
+	// Input
+	UEdGraphPin* InTargetPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Object, UCurveBase::StaticClass(), FTaggedCurveValuesGetPinName::GetTargetPin());
+	
+#if ENGINE_MAJOR_VERSION >= 5
+	UEdGraphPin* InValuePin = CreatePin(EGPD_Input,  UEdGraphSchema_K2::PC_Real, UEdGraphSchema_K2::PC_Double, FTaggedCurveValuesGetPinName::GetInTimePin());
+#else
+	UEdGraphPin* InValuePin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Float, FTaggedCurveValuesGetPinName::GetInTimePin());
+#endif 
+	K2Schema->SetPinAutogeneratedDefaultValueBasedOnType(InValuePin);
+
+	UEdGraphPin* TagsPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Struct, FGameplayTagContainer::StaticStruct(), FTaggedCurveValuesGetPinName::GetTagsPin());
+	K2Schema->SetPinAutogeneratedDefaultValue(TagsPin, Tags.ToString());
+	TagsPin->bAdvancedView = true;
+
+	UEdGraphPin* AllowParamLookupPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Boolean, FTaggedCurveValuesGetPinName::GetAllowParamLookupPin());
+	K2Schema->SetPinAutogeneratedDefaultValue(AllowParamLookupPin, bAllowParamLookup ? TEXT("true") : TEXT("false"));
+	AllowParamLookupPin->bAdvancedView = true;
+
+	// Output
+
+	// Refresh
+	for (FGameplayTag Tag : Tags)
+	{
+#if ENGINE_MAJOR_VERSION >= 5
+		UEdGraphPin* OutValidPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Real, UEdGraphSchema_K2::PC_Double, Tag.GetTagName());
+#else
+		UEdGraphPin* OutValidPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Float, Tag.GetTagName());
+#endif 
+		//OutValidPin->bAdvancedView = true;
+		K2Schema->SetPinAutogeneratedDefaultValueBasedOnType(OutValidPin);
+	}
+
+	if (ENodeAdvancedPins::NoPins == AdvancedPinDisplay)
+	{
+		AdvancedPinDisplay = ENodeAdvancedPins::Shown;
+	}
+}
+
+FText UK2Node_CurviestGetTaggedCurveValues::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("K2Node_CurviestGetTaggedCurveValues_Title", "Get Tagged Curve Values");
+}
+
+FText UK2Node_CurviestGetTaggedCurveValues::GetTooltipText() const
+{
+	return LOCTEXT("K2Node_CurviestGetCurveValues_Tooltip", "Easily get float values out of any curve.");
+}
+
+FSlateIcon UK2Node_CurviestGetTaggedCurveValues::GetIconAndTint(FLinearColor& OutColor) const
+{
+	OutColor = bIsPureNode ? GetDefault<UGraphEditorSettings>()->PureFunctionCallNodeTitleColor : GetDefault<UGraphEditorSettings>()->FunctionCallNodeTitleColor;
+	static FSlateIcon Icon("EditorStyle", "Kismet.AllClasses.FunctionIcon");
+	return Icon;
+}
+
+void UK2Node_CurviestGetTaggedCurveValues::PinDefaultValueChanged(UEdGraphPin* Pin)
+{
+	Super::PinDefaultValueChanged(Pin);
+
+	if (Pin == FindPin(FTaggedCurveValuesGetPinName::GetTagsPin()))
+	{
+		Tags.FromExportString(Pin->DefaultValue);
+
+		ReconstructNode();
+		GetGraph()->NotifyGraphChanged();
+	}
+	else if (Pin == FindPin(FTaggedCurveValuesGetPinName::GetAllowParamLookupPin()))
+	{
+		bAllowParamLookup = Pin->DefaultValue == TEXT("true");
+	}
+}
+
+void UK2Node_CurviestGetTaggedCurveValues::PreloadRequiredAssets()
+{
+	Super::PreloadRequiredAssets();
+}
+
+
+FText UK2Node_CurviestGetTaggedCurveValues::GetMenuCategory() const
+{
+	return LOCTEXT("K2Node_CurviestGetCurveValues_MenuCategory", "Curves");
+}
+
+void UK2Node_CurviestGetTaggedCurveValues::ExpandNode(class FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	const UEdGraphSchema_K2* K2Schema = GetDefault<UEdGraphSchema_K2>();
+
+	// The linked tags are baked into an object owned by the generated class and passed as a literal. If the target
+	// is a fixed asset the tags are also resolved to slots now, so the call only compares a layout hash.
+	UCurviestCurveValueList* ValueList = NewObject<UCurviestCurveValueList>(CompilerContext.NewClass, MakeUniqueObjectName(CompilerContext.NewClass, UCurviestCurveValueList::StaticClass()));
+	TArray<UEdGraphPin*> LinkedOutPins;
+	for (FGameplayTag Tag : Tags)
+	{
+		UEdGraphPin* OutPin = FindPin(Tag.GetTagName());
+		if (OutPin && OutPin->LinkedTo.Num() > 0)
+		{
+			ValueList->Tags.Add(Tag);
+			LinkedOutPins.Add(OutPin);
+		}
+	}
+	ValueList->bAllowParamLookup = bAllowParamLookup;
+
+	UEdGraphPin* TargetPin = FindPin(FTaggedCurveValuesGetPinName::GetTargetPin());
+	if (TargetPin->LinkedTo.Num() == 0)
+	{
+		ValueList->ResolveSlots(Cast<UCurveCurviest>(TargetPin->DefaultObject));
+	}
+
+	// Without exec pins each linked output gets its own pure call for its entry, so a read only evaluates the
+	// tag it needs. With exec pins one native call evaluates every linked tag into a temporary, and each output
+	// reads its element with an array get.
+	if (bIsPureNode)
+	{
+		UFunction* Func_GetValueFromValueList = UCurveCurviestBlueprintUtils::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UCurveCurviestBlueprintUtils, GetValueFromValueList));
+		for (int TagIdx = 0; TagIdx < LinkedOutPins.Num(); TagIdx++)
+		{
+			UK2Node_CallFunction* CallFuncNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+			CallFuncNode->SetFromFunction(Func_GetValueFromValueList);
+			CallFuncNode->AllocateDefaultPins();
+
+			CompilerContext.MessageLog.NotifyIntermediateObjectCreation(CallFuncNode, this);
+
+			//Input
+			CompilerContext.CopyPinLinksToIntermediate(*TargetPin, *CallFuncNode->FindPin(TEXT("Curve")));
+			K2Schema->TrySetDefaultObject(*CallFuncNode->FindPin(TEXT("ValueList")), ValueList);
+			K2Schema->SetPinAutogeneratedDefaultValue(CallFuncNode->FindPin(TEXT("Index")), FString::FromInt(TagIdx));
+			CompilerContext.CopyPinLinksToIntermediate(*FindPin(FTaggedCurveValuesGetPinName::GetInTimePin()), *CallFuncNode->FindPin(TEXT("InTime")));
+
+			//Output
+			CompilerContext.MovePinLinksToIntermediate(*LinkedOutPins[TagIdx], *CallFuncNode->GetReturnValuePin());
+		}
+
+		BreakAllNodeLinks();
+		return;
+	}
+
+	UFunction* Func_EvaluateValuesFromCurve = UCurveCurviestBlueprintUtils::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UCurveCurviestBlueprintUtils, EvaluateValuesFromCurve));
+	UK2Node_CallFunction* CallFuncNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	CallFuncNode->SetFromFunction(Func_EvaluateValuesFromCurve);
+	CallFuncNode->AllocateDefaultPins();
+
+	CompilerContext.MessageLog.NotifyIntermediateObjectCreation(CallFuncNode, this);
+
+	//Input
+	CompilerContext.CopyPinLinksToIntermediate(*TargetPin, *CallFuncNode->FindPin(TEXT("Curve")));
+
+	UEdGraphPin* ValueListPin = CallFuncNode->FindPin(TEXT("ValueList"));
+	K2Schema->TrySetDefaultObject(*ValueListPin, ValueList);
+
+	CompilerContext.CopyPinLinksToIntermediate(*FindPin(FTaggedCurveValuesGetPinName::GetInTimePin()), *CallFuncNode->FindPin(TEXT("InTime")));
+
+	//Output
+	UEdGraphPin* ValuesPin = CallFuncNode->FindPin(TEXT("Values"));
+	UK2Node_TemporaryVariable* ValuesNode = CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(this, SourceGraph);
+	ValuesNode->VariableType = ValuesPin->PinType;
+	ValuesNode->VariableType.bIsReference = false;
+	ValuesNode->AllocateDefaultPins();
+
+	CompilerContext.MessageLog.NotifyIntermediateObjectCreation(ValuesNode, this);
+
+	K2Schema->TryCreateConnection(ValuesNode->GetVariablePin(), ValuesPin);
+	ValuesPin = ValuesNode->GetVariablePin();
+
+	CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *CallFuncNode->GetExecPin());
+	CompilerContext.MovePinLinksToIntermediate(*GetThenPin(), *CallFuncNode->GetThenPin());
+
+	for (int TagIdx = 0; TagIdx < LinkedOutPins.Num(); TagIdx++)
+	{
+		UK2Node_GetArrayItem* GetItemNode = CompilerContext.SpawnIntermediateNode<UK2Node_GetArrayItem>(this, SourceGraph);
+		GetItemNode->AllocateDefaultPins();
+
+		CompilerContext.MessageLog.NotifyIntermediateObjectCreation(GetItemNode, this);
+
+		K2Schema->TryCreateConnection(ValuesPin, GetItemNode->GetTargetArrayPin());
+		K2Schema->SetPinAutogeneratedDefaultValue(GetItemNode->GetIndexPin(), FString::FromInt(TagIdx));
+
+		CompilerContext.MovePinLinksToIntermediate(*LinkedOutPins[TagIdx], *GetItemNode->GetResultPin());
+	}
+
+	BreakAllNodeLinks();
+}
+
+
+//This method adds our node to the context menu
+void UK2Node_CurviestGetTaggedCurveValues::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	Super::GetMenuActions(ActionRegistrar);
+
+	UClass* Action = GetClass();
+
+	if (ActionRegistrar.IsOpenForRegistration(Action)) {
+		UBlueprintNodeSpawner* Spawner = UBlueprintNodeSpawner::Create(GetClass());
+		check(Spawner != nullptr);
+
+		ActionRegistrar.AddBlueprintAction(Action, Spawner);
+	}
+}
+
+void UK2Node_CurviestGetTaggedCurveValues::GetNodeContextMenuActions(UToolMenu* Menu, UGraphNodeContextMenuContext* Context) const
+{
+	Super::GetNodeContextMenuActions(Menu, Context);
+
+	FToolMenuSection& Section = Menu->AddSection("K2NodeCurviestGetTaggedCurveValues", LOCTEXT("CurviestGetCurveValuesHeader", "Curviest"));
+	Section.AddMenuEntry(
+		"TogglePurity",
+		bIsPureNode ? LOCTEXT("ConvertToImpure", "Convert to Impure") : LOCTEXT("ConvertToPure", "Convert to Pure"),
+		bIsPureNode ? LOCTEXT("ConvertToImpureTooltip", "Add exec pins, so the curves are evaluated once per execution however many nodes read the outputs.")
+			: LOCTEXT("ConvertToPureTooltip", "Remove the exec pins. Each output evaluates its own curve whenever it is read."),
+		FSlateIcon(),
+		FUIAction(
+			FExecuteAction::CreateUObject(const_cast<UK2Node_CurviestGetTaggedCurveValues*>(this), &UK2Node_CurviestGetTaggedCurveValues::TogglePurity),
+			FCanExecuteAction(),
+			FIsActionChecked()
+		)
+	);
+	/*
+	Section.AddMenuEntry(
+		"RefreshNode",
+		LOCTEXT("RefreshNode", "Refresh Node"),
+		LOCTEXT("RefreshNodeTooltip", "Refresh this node."),
+		FSlateIcon(),
+		FUIAction(
+			FExecuteAction::CreateUObject(const_cast<UK2Node_CurviestGetTaggedCurveValues*>(this), &UK2Node_CurviestGetTaggedCurveValues::RefreshTemplateCurve),
+			FCanExecuteAction(),
+			FIsActionChecked()
+		)
+	);*/
+}
+
+void UK2Node_CurviestGetTaggedCurveValues::TogglePurity()
+{
+	const FScopedTransaction Transaction(bIsPureNode ? LOCTEXT("ConvertToImpureTransaction", "Convert to Impure") : LOCTEXT("ConvertToPureTransaction", "Convert to Pure"));
+	Modify();
+
+	bIsPureNode = !bIsPureNode;
+	ReconstructNode();
+	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
+}
+
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -1,5 +1,5 @@
-// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
-
-#include "TheCurviestCurveUncooked.h"
-
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "TheCurviestCurveUncooked.h"
+
 IMPLEMENT_MODULE(FDefaultModuleImpl, TheCurviestCurveUncooked)
\ No newline at end of file